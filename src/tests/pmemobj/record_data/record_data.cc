@@ -0,0 +1,69 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "record_data.h"
+#include <fstream>
+#include <utility>
+#include <vector>
+
+void PmemobjRecordDataTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  ApiC::RemoveFile(histogram_path_);
+}
+
+void PmemobjRecordDataTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+  ApiC::RemoveFile(histogram_path_);
+}
+
+int PmemobjRecordDataTest::WriteHistogram(const std::string &content) {
+  std::ofstream file(histogram_path_);
+  file << content;
+  return file ? 0 : -1;
+}
+
+std::unique_ptr<SizeDistribution> PmemobjRecordDataTest::MakeDistribution(
+    SizeDistributionType type) {
+  if (type != SizeDistributionType::HISTOGRAM) {
+    return std::make_unique<SizeDistribution>(type, min_size, max_size);
+  }
+
+  std::vector<std::pair<size_t, double>> histogram;
+  if (SizeDistribution::LoadHistogram(histogram_path_, histogram) != 0) {
+    return nullptr;
+  }
+  return std::make_unique<SizeDistribution>(histogram);
+}
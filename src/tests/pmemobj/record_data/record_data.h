@@ -0,0 +1,83 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_RECORD_DATA_H
+#define PMDK_TESTS_RECORD_DATA_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/size_distribution.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjRecordDataTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string histogram_path_ = test_dir_ + "histogram";
+  const std::string layout_ = "record_data";
+  const size_t pool_size = 64 * MEBIBYTE;
+  const size_t min_size = 64;
+  const size_t max_size = 4 * KIBIBYTE;
+  const size_t nof_written = 1000;
+  const size_t nof_reserved = 100;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * WriteHistogram -- writes given content to the histogram file. Returns 0
+   * on success, -1 otherwise.
+   */
+  int WriteHistogram(const std::string &content);
+
+  /*
+   * MakeDistribution -- creates distribution of given type over [min_size,
+   * max_size]. HISTOGRAM distribution is loaded from the histogram file
+   * written beforehand. Returns nullptr on failure.
+   */
+  std::unique_ptr<SizeDistribution> MakeDistribution(
+      SizeDistributionType type);
+};
+
+class PmemobjRecordDataParamTest
+    : public PmemobjRecordDataTest,
+      public ::testing::WithParamInterface<SizeDistributionType> {};
+
+#endif  // PMDK_TESTS_RECORD_DATA_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "record_data.h"
+#include <utility>
+#include <vector>
+#include "pool_data/record_data.h"
+
+/**
+ * RECORD_DATA_WRITE_VERIFY
+ * Parameterized Test Case: Checks that variable-length records with sizes
+ * drawn from given distribution are written and verified correctly and
+ * survive pool reopen
+ * \test
+ *          \li \c Step1. Create the pmemobj pool and the distribution of
+ *          sizes from 64 B to 4 KiB, loading HISTOGRAM distribution from a
+ *          file / SUCCESS
+ *          \li \c Step2. Write 1000 records / SUCCESS
+ *          \li \c Step3. Reserve 100 records and publish them / SUCCESS
+ *          \li \c Step4. Close, check and reopen the pool / SUCCESS
+ *          \li \c Step5. Verify all records / SUCCESS
+ *          \li \c Step6. Corrupt a payload byte of the first record
+ *          \li \c Step7. Verify that the corrupted record is detected
+ *          / FAIL
+ */
+TEST_P(PmemobjRecordDataParamTest, RECORD_DATA_WRITE_VERIFY) {
+  /* Step 1 */
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  ASSERT_EQ(0, WriteHistogram("# size count\n"
+                              "64 50\n"
+                              "256 30\n"
+                              "\n"
+                              "1000 15\n"
+                              "4096 5\n"));
+  auto sizes = MakeDistribution(GetParam());
+  ASSERT_TRUE(sizes != nullptr);
+  RecordData records(pop, *sizes);
+
+  /* Step 2 */
+  ASSERT_EQ(0, records.Write(nof_written));
+
+  /* Step 3 */
+  std::vector<pobj_action> actions(nof_reserved);
+  for (auto &act : actions) {
+    ASSERT_FALSE(OID_IS_NULL(records.Reserve(&act))) << pmemobj_errormsg();
+  }
+  ASSERT_EQ(0, pmemobj_publish(pop, actions.data(), actions.size()))
+      << pmemobj_errormsg();
+
+  /* Step 4 */
+  pmemobj_close(pop);
+  pop = nullptr;
+  ASSERT_EQ(1, pmemobj_check(pool_path_.c_str(), layout_.c_str()))
+      << pmemobj_errormsg();
+  pop = pmemobj_open(pool_path_.c_str(), layout_.c_str());
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  RecordData reopened(pop, *sizes);
+
+  /* Step 5 */
+  size_t nof_records = 0;
+  ASSERT_EQ(0, reopened.Verify(nof_records));
+  ASSERT_EQ(nof_written + nof_reserved, nof_records);
+
+  /* Step 6 */
+  PMEMoid first = pmemobj_first(pop);
+  ASSERT_TRUE(reopened.Verify(first));
+  /* records are at least min_size bytes long, so the byte is in payload */
+  auto data = static_cast<char *>(pmemobj_direct(first));
+  data[min_size / 2] = static_cast<char>(~data[min_size / 2]);
+
+  /* Step 7 */
+  ASSERT_FALSE(reopened.Verify(first));
+  ASSERT_EQ(-1, reopened.Verify(nof_records));
+}
+
+/**
+ * RECORD_DATA_INVALID_HISTOGRAM
+ * Test Case: Checks that histogram files with zero or negative size, negative
+ * count, trailing characters or no positive count are rejected
+ * \test
+ *          \li \c Step1. Load histogram with entry of size 0 / FAIL
+ *          \li \c Step2. Load histogram with negative count / FAIL
+ *          \li \c Step3. Load histogram with all counts equal to 0 / FAIL
+ *          \li \c Step4. Load histogram with negative size / FAIL
+ *          \li \c Step5. Load histogram with trailing characters in entry
+ *          / FAIL
+ */
+TEST_F(PmemobjRecordDataTest, RECORD_DATA_INVALID_HISTOGRAM) {
+  std::vector<std::pair<size_t, double>> histogram;
+
+  /* Step 1 */
+  ASSERT_EQ(0, WriteHistogram("0 10\n64 10\n"));
+  ASSERT_EQ(-1, SizeDistribution::LoadHistogram(histogram_path_, histogram));
+
+  /* Step 2 */
+  histogram.clear();
+  ASSERT_EQ(0, WriteHistogram("64 -1\n128 10\n"));
+  ASSERT_EQ(-1, SizeDistribution::LoadHistogram(histogram_path_, histogram));
+
+  /* Step 3 */
+  histogram.clear();
+  ASSERT_EQ(0, WriteHistogram("64 0\n128 0\n"));
+  ASSERT_EQ(-1, SizeDistribution::LoadHistogram(histogram_path_, histogram));
+
+  /* Step 4 */
+  histogram.clear();
+  ASSERT_EQ(0, WriteHistogram("-5 10\n64 10\n"));
+  ASSERT_EQ(-1, SizeDistribution::LoadHistogram(histogram_path_, histogram));
+
+  /* Step 5 */
+  histogram.clear();
+  ASSERT_EQ(0, WriteHistogram("64 1 junk\n128 10\n"));
+  ASSERT_EQ(-1, SizeDistribution::LoadHistogram(histogram_path_, histogram));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    RecordData, PmemobjRecordDataParamTest,
+    ::testing::Values(SizeDistributionType::FIXED,
+                      SizeDistributionType::UNIFORM,
+                      SizeDistributionType::LOGNORMAL,
+                      SizeDistributionType::BIMODAL,
+                      SizeDistributionType::ZIPF,
+                      SizeDistributionType::HISTOGRAM));
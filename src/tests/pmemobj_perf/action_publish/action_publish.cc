@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "action_publish.h"
+
+void PmemobjActionPublishPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  PMEMoid root_oid = pmemobj_root(pop, max_actions * sizeof(uint64_t));
+  ASSERT_FALSE(OID_IS_NULL(root_oid)) << pmemobj_errormsg();
+  values = static_cast<uint64_t *>(pmemobj_direct(root_oid));
+}
+
+void PmemobjActionPublishPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+size_t PmemobjActionPublishPerfTest::GetNofSetValues(
+    size_t nof_actions) const {
+  return nof_actions - 2 * (nof_actions / 4);
+}
+
+int PmemobjActionPublishPerfTest::PrepareActions(
+    size_t nof_actions, std::vector<pobj_action> &actions, uint64_t value) {
+  const size_t nof_objects = nof_actions / 4;
+  std::vector<PMEMoid> to_free;
+  size_t i = 0;
+
+  actions.resize(nof_actions);
+  to_free.swap(reserved);
+
+  /* first publish of given size has no reserved objects to free yet */
+  while (to_free.size() < nof_objects) {
+    PMEMoid oid = OID_NULL;
+    if (pmemobj_alloc(pop, &oid, object_size, 0, nullptr, nullptr) != 0) {
+      return -1;
+    }
+    to_free.push_back(oid);
+  }
+
+  for (size_t j = 0; j < nof_objects; ++i, ++j) {
+    PMEMoid oid = pmemobj_reserve(pop, &actions[i], object_size, 0);
+    if (OID_IS_NULL(oid)) {
+      pmemobj_cancel(pop, actions.data(), i);
+      return -1;
+    }
+    reserved.push_back(oid);
+  }
+  for (size_t j = 0; j < nof_objects; ++i, ++j) {
+    pmemobj_defer_free(pop, to_free[j], &actions[i]);
+  }
+  for (size_t j = 0; i < nof_actions; ++i, ++j) {
+    pmemobj_set_value(pop, &actions[i], &values[j], value);
+  }
+
+  return 0;
+}
+
+bool PmemobjActionPublishPerfTest::VerifyValues(size_t nof_values,
+                                                uint64_t value) const {
+  for (size_t i = 0; i < nof_values; ++i) {
+    if (values[i] != value) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_ACTION_PUBLISH_PERF_H
+#define PMDK_TESTS_ACTION_PUBLISH_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjActionPublishPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  uint64_t *values = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "action_publish_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  const size_t object_size = 64;
+  const size_t max_actions = 65536;
+  /* number of actions published for each action set size */
+  const size_t actions_per_size = 65536;
+  const size_t min_repeats = 10;
+  /* objects reserved in the previous publish, freed in the next one */
+  std::vector<PMEMoid> reserved;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * PrepareActions -- fills actions with nof_actions actions: a quarter of
+   * them reserves new objects, a quarter frees objects reserved in the
+   * previous publish with pmemobj_defer_free and the rest sets consecutive
+   * root object values to given value with pmemobj_set_value. Returns 0 on
+   * success, -1 otherwise.
+   */
+  int PrepareActions(size_t nof_actions, std::vector<pobj_action> &actions,
+                     uint64_t value);
+
+  /*
+   * GetNofSetValues -- returns number of pmemobj_set_value actions in action
+   * set of given size.
+   */
+  size_t GetNofSetValues(size_t nof_actions) const;
+
+  /*
+   * VerifyValues -- checks that first nof_values root object values are
+   * equal to given value.
+   */
+  bool VerifyValues(size_t nof_values, uint64_t value) const;
+};
+
+#endif  // PMDK_TESTS_ACTION_PUBLISH_PERF_H
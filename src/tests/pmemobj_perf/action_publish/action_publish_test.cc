@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <algorithm>
+#include "action_publish.h"
+#include "perf/latency_stats.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+/**
+ * ACTION_PUBLISH_SCALING
+ * Test Case: Measures latency of pmemobj_publish for action sets of growing
+ * size (n), from 1 action up to 65536 actions or the first size rejected by
+ * libpmemobj. Each action set consists of n / 4 pmemobj_reserve actions, n / 4
+ * pmemobj_defer_free actions freeing objects reserved by the previous publish
+ * and pmemobj_set_value actions updating the root object.
+ * \test
+ *          \li \c Step1. Prepare action set of size n / SUCCESS
+ *          \li \c Step2. Publish the actions with pmemobj_publish measuring
+ *          its latency
+ *          \li \c Step3. Verify values set by pmemobj_set_value actions
+ *          \li \c Step4. Repeat steps 1-3 so that at least 65536 actions (and
+ *          at least 10 action sets) are published, report publish latency and
+ *          mean latency per action for n
+ *          \li \c Step5. Double n and repeat steps 1-4 until n exceeds 65536 or
+ *          pmemobj_publish fails
+ *          \li \c Step6. Report the largest published action set, the action
+ *          set size with the lowest latency per action and the size with the
+ *          largest increase of mean publish latency compared to half the
+ *          size, which indicates redo log extension
+ */
+TEST_F(PmemobjActionPublishPerfTest, ACTION_PUBLISH_SCALING) {
+  std::vector<pobj_action> actions;
+  uint64_t value = 0;
+  size_t max_published = 0;
+  size_t optimal_size = 0;
+  double min_per_action = 0;
+  size_t jump_size = 0;
+  double max_jump = 0;
+  double prev_mean = 0;
+
+  /* Step 5 */
+  for (size_t n = 1; n <= max_actions; n *= 2) {
+    const size_t repeats = std::max(min_repeats, actions_per_size / n);
+    LatencyStats stats;
+    bool published = true;
+
+    /* Step 4 */
+    for (size_t i = 0; i < repeats && published; ++i) {
+      /* Step 1 */
+      ASSERT_EQ(0, PrepareActions(n, actions, ++value)) << pmemobj_errormsg();
+
+      /* Step 2 */
+      Stopwatch stopwatch;
+      published = pmemobj_publish(pop, actions.data(), n) == 0;
+      uint64_t elapsed = stopwatch.ElapsedNs();
+
+      if (!published) {
+        perf_report::Record("publish_error", pmemobj_errormsg());
+        pmemobj_cancel(pop, actions.data(), n);
+        break;
+      }
+      stats.Add(elapsed);
+
+      /* Step 3 */
+      ASSERT_TRUE(VerifyValues(GetNofSetValues(n), value));
+    }
+
+    if (!published) {
+      break;
+    }
+
+    const std::string prefix = "actions_" + std::to_string(n);
+    double mean = stats.GetMean();
+    double per_action = mean / n;
+    perf_report::RecordLatency(prefix + "_publish", stats);
+    perf_report::Record(prefix + "_per_action", per_action, "ns");
+
+    max_published = n;
+    if (optimal_size == 0 || per_action < min_per_action) {
+      optimal_size = n;
+      min_per_action = per_action;
+    }
+    if (prev_mean > 0 && mean / prev_mean > max_jump) {
+      jump_size = n;
+      max_jump = mean / prev_mean;
+    }
+    prev_mean = mean;
+  }
+
+  /* Step 6 */
+  perf_report::Record("max_published_actions", max_published);
+  perf_report::Record("optimal_actions", optimal_size);
+  perf_report::Record("largest_latency_jump_at", jump_size);
+  perf_report::Record("largest_latency_jump", max_jump);
+}
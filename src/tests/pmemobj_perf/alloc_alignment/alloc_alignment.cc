@@ -0,0 +1,146 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "alloc_alignment.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "perf/stopwatch.h"
+
+void PmemobjAllocAlignmentPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjAllocAlignmentPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+size_t PmemobjAllocAlignmentPerfTest::GetUnitSize(size_t size,
+                                                  size_t alignment) const {
+  if (alignment == 0) {
+    return size;
+  }
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+int PmemobjAllocAlignmentPerfTest::RegisterClass(size_t size,
+                                                 size_t alignment) {
+  pobj_alloc_class_desc desc;
+  desc.unit_size = GetUnitSize(size, alignment);
+  desc.alignment = alignment;
+  desc.units_per_block = static_cast<unsigned>(
+      std::max(size_t{1}, 256 * KIBIBYTE / desc.unit_size));
+  desc.header_type = POBJ_HEADER_NONE;
+  if (pmemobj_ctl_set(pop, "heap.alloc_class.new.desc", &desc) != 0) {
+    std::cerr << "Registering allocation class with alignment " << alignment
+              << " failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+  class_id_ = desc.class_id;
+  return 0;
+}
+
+int PmemobjAllocAlignmentPerfTest::AllocateObjects(size_t size,
+                                                   size_t alignment) {
+  const size_t nof_objects = working_set / GetUnitSize(size, alignment);
+  const uint64_t flags = POBJ_XALLOC_ZERO | POBJ_CLASS_ID(class_id_);
+
+  objects.reserve(nof_objects);
+  for (size_t i = 0; i < nof_objects; ++i) {
+    PMEMoid oid = OID_NULL;
+    if (pmemobj_xalloc(pop, &oid, size, 0, flags, nullptr, nullptr) != 0) {
+      std::cerr << "Allocation of object " << i
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+    objects.push_back(static_cast<char *>(pmemobj_direct(oid)));
+  }
+  return 0;
+}
+
+bool PmemobjAllocAlignmentPerfTest::IsAligned(size_t alignment) const {
+  if (alignment == 0) {
+    return true;
+  }
+  for (const char *object : objects) {
+    if (reinterpret_cast<uintptr_t>(object) % alignment != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t PmemobjAllocAlignmentPerfTest::RunWorkload(size_t size) {
+  std::uniform_int_distribution<size_t> index(0, objects.size() - 1);
+  std::vector<char> buffer(size);
+
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < nof_ops; ++i) {
+    char *object = objects[index(generator)];
+    uint64_t counter;
+
+    memcpy(buffer.data(), object, size);
+    memcpy(&counter, buffer.data(), sizeof(counter));
+    counter++;
+    memset(buffer.data() + sizeof(counter), static_cast<int>(counter),
+           size - sizeof(counter));
+    memcpy(buffer.data(), &counter, sizeof(counter));
+    pmemobj_memcpy_persist(pop, object, buffer.data(), size);
+  }
+  return stopwatch.ElapsedNs();
+}
+
+uint64_t PmemobjAllocAlignmentPerfTest::GetCounterSum() const {
+  uint64_t sum = 0;
+  for (const char *object : objects) {
+    uint64_t counter;
+    memcpy(&counter, object, sizeof(counter));
+    sum += counter;
+  }
+  return sum;
+}
+
+double PmemobjAllocAlignmentPerfTest::GetSpaceOverhead(size_t size) {
+  uint64_t run_active = 0;
+
+  if (pmemobj_ctl_get(pop, "stats.heap.run_active", &run_active) != 0) {
+    return -1;
+  }
+  return static_cast<double>(run_active) / (objects.size() * size) - 1;
+}
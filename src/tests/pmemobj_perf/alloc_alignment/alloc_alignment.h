@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_ALLOC_ALIGNMENT_PERF_H
+#define PMDK_TESTS_ALLOC_ALIGNMENT_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjAllocAlignmentPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "alloc_alignment_perf";
+  const size_t pool_size = 512 * MEBIBYTE;
+  /* number of bytes of units occupied by all objects of a class */
+  const size_t working_set = 64 * MEBIBYTE;
+  const size_t nof_ops = 1000000;
+  unsigned class_id_ = 0;
+  std::vector<char *> objects;
+  std::mt19937_64 generator;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * GetUnitSize -- returns object size rounded up to the alignment.
+   */
+  size_t GetUnitSize(size_t size, size_t alignment) const;
+
+  /*
+   * RegisterClass -- registers allocation class without object headers for
+   * objects of given size with given alignment (0 for no alignment). Returns
+   * 0 on success, prints error message and returns -1 otherwise.
+   */
+  int RegisterClass(size_t size, size_t alignment);
+
+  /*
+   * AllocateObjects -- allocates objects of given size from the class
+   * registered with given alignment until their units fill working_set
+   * bytes. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  int AllocateObjects(size_t size, size_t alignment);
+
+  /*
+   * IsAligned -- checks that all allocated objects are aligned to given
+   * alignment.
+   */
+  bool IsAligned(size_t alignment) const;
+
+  /*
+   * RunWorkload -- nof_ops times reads randomly chosen object, increments
+   * counter stored in its first 8 bytes, rewrites the whole object and
+   * persists it. Returns elapsed time in nanoseconds.
+   */
+  uint64_t RunWorkload(size_t size);
+
+  /*
+   * GetCounterSum -- returns sum of counters of all objects.
+   */
+  uint64_t GetCounterSum() const;
+
+  /*
+   * GetSpaceOverhead -- returns ratio of memory in active runs to requested
+   * bytes minus 1, calculated from heap statistics. Returns -1 if statistics
+   * are not supported by libpmemobj.
+   */
+  double GetSpaceOverhead(size_t size);
+};
+
+class PmemobjAllocAlignmentPerfParamTest
+    : public PmemobjAllocAlignmentPerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
+
+#endif  // PMDK_TESTS_ALLOC_ALIGNMENT_PERF_H
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "alloc_alignment.h"
+#include "perf/perf_report.h"
+
+/**
+ * ALLOC_ALIGNMENT
+ * Parameterized Test Case: Measures throughput of read-modify-persist
+ * workload on objects of given size (s) allocated from custom allocation
+ * class with given alignment (a), where alignment 0 means no alignment, and
+ * space overhead of the alignment
+ * \test
+ *          \li \c Step1. Enable heap statistics and register allocation class
+ *          without headers with unit size s rounded up to a and alignment a
+ *          (skip if not supported by libpmemobj) / SUCCESS
+ *          \li \c Step2. Allocate objects from the class until their units
+ *          occupy 64 MiB / SUCCESS
+ *          \li \c Step3. Verify that objects are aligned to a
+ *          \li \c Step4. 1000000 times read randomly chosen object, increment
+ *          its counter, rewrite and persist the whole object measuring total
+ *          time
+ *          \li \c Step5. Verify that sum of counters equals number of
+ *          operations
+ *          \li \c Step6. Report throughput, bandwidth and space overhead
+ */
+TEST_P(PmemobjAllocAlignmentPerfParamTest, ALLOC_ALIGNMENT) {
+  const size_t size = std::get<0>(GetParam());
+  const size_t alignment = std::get<1>(GetParam());
+
+  /* Step 1 */
+  enum pobj_stats_enabled stats_enabled = POBJ_STATS_ENABLED_TRANSIENT;
+  ASSERT_EQ(0, pmemobj_ctl_set(pop, "stats.enabled", &stats_enabled))
+      << pmemobj_errormsg();
+  if (RegisterClass(size, alignment) != 0) {
+    return;
+  }
+
+  /* Step 2 */
+  ASSERT_EQ(0, AllocateObjects(size, alignment));
+
+  /* Step 3 */
+  ASSERT_TRUE(IsAligned(alignment));
+
+  /* Step 4 */
+  uint64_t elapsed = RunWorkload(size);
+
+  /* Step 5 */
+  ASSERT_EQ(nof_ops, GetCounterSum());
+
+  /* Step 6 */
+  perf_report::Record("size", size, "B");
+  perf_report::Record("alignment", alignment, "B");
+  perf_report::Record("unit_size", GetUnitSize(size, alignment), "B");
+  perf_report::Record("throughput", perf_report::OpsPerSec(nof_ops, elapsed),
+                      "ops/s");
+  perf_report::Record(
+      "bandwidth",
+      static_cast<double>(nof_ops * size) / MEBIBYTE / (elapsed / 1e9),
+      "MiB/s");
+  perf_report::Record("space_overhead", GetSpaceOverhead(size));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    AllocAlignment, PmemobjAllocAlignmentPerfParamTest,
+    ::testing::Combine(::testing::Values(64, 200, 256, 1000, 4 * KIBIBYTE),
+                       ::testing::Values(0, 64, 256, 4 * KIBIBYTE)));
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "alloc_class_count.h"
+#include <algorithm>
+#include "perf/stopwatch.h"
+
+void PmemobjAllocClassCountPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjAllocClassCountPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+unsigned PmemobjAllocClassCountPerfTest::RegisterClasses(
+    unsigned nof_classes) {
+  pobj_alloc_class_desc desc;
+  desc.header_type = POBJ_HEADER_COMPACT;
+  desc.alignment = 0;
+  desc.units_per_block = 512;
+
+  for (unsigned i = 0; i < nof_classes; ++i) {
+    desc.unit_size = (i + 1) * 512;
+    if (pmemobj_ctl_set(pop, "heap.alloc_class.new.desc", &desc) != 0) {
+      std::cerr << "Registering allocation class " << i
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return i;
+    }
+  }
+  return nof_classes;
+}
+
+int PmemobjAllocClassCountPerfTest::MeasureAlloc(size_t size,
+                                                 LatencyStats &stats) {
+  const size_t nof_objects = std::min(max_objects, bytes_per_size / size);
+  std::vector<PMEMoid> objects(nof_objects, OID_NULL);
+  int ret = 0;
+
+  stats.Reserve(nof_objects);
+  for (auto &oid : objects) {
+    Stopwatch stopwatch;
+    ret = pmemobj_alloc(pop, &oid, size, 0, nullptr, nullptr);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+
+    if (ret != 0) {
+      std::cerr << "Allocation of object of size " << size
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      break;
+    }
+    stats.Add(elapsed);
+  }
+
+  for (auto &oid : objects) {
+    pmemobj_free(&oid);
+  }
+  return ret == 0 ? 0 : -1;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_ALLOC_CLASS_COUNT_PERF_H
+#define PMDK_TESTS_ALLOC_CLASS_COUNT_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjAllocClassCountPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "alloc_class_count_perf";
+  const size_t pool_size = 512 * MEBIBYTE;
+  /* sizes of objects allocated from default allocation classes */
+  const std::vector<size_t> sizes = {64, KIBIBYTE, 16 * KIBIBYTE,
+                                     128 * KIBIBYTE};
+  /* number of bytes allocated for each size, bounded by max_objects */
+  const size_t bytes_per_size = 128 * MEBIBYTE;
+  const size_t max_objects = 100000;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * RegisterClasses -- registers up to nof_classes custom allocation classes
+   * with unit sizes being multiples of 512 B. Returns number of registered
+   * classes.
+   */
+  unsigned RegisterClasses(unsigned nof_classes);
+
+  /*
+   * MeasureAlloc -- allocates objects of given size with pmemobj_alloc,
+   * collecting latency of each allocation, and frees them. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  int MeasureAlloc(size_t size, LatencyStats &stats);
+};
+
+class PmemobjAllocClassCountPerfParamTest
+    : public PmemobjAllocClassCountPerfTest,
+      public ::testing::WithParamInterface<unsigned> {};
+
+#endif  // PMDK_TESTS_ALLOC_CLASS_COUNT_PERF_H
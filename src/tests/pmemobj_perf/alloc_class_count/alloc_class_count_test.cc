@@ -0,0 +1,78 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "alloc_class_count.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+/**
+ * ALLOC_CLASS_COUNT
+ * Parameterized Test Case: Measures latency of pmemobj_alloc of objects from
+ * default allocation classes with given number (n) of custom allocation
+ * classes registered
+ * \test
+ *          \li \c Step1. Register n custom allocation classes measuring total
+ *          registration time / SUCCESS
+ *          \li \c Step2. Allocate objects of 64 B, 1 KiB, 16 KiB and 128 KiB
+ *          with pmemobj_alloc measuring latency of each allocation and free
+ *          them / SUCCESS
+ *          \li \c Step3. Report number of registered classes, registration
+ *          time and allocation latency percentiles for each size
+ *          \li \c Step4. Verify that the pool is empty
+ */
+TEST_P(PmemobjAllocClassCountPerfParamTest, ALLOC_CLASS_COUNT) {
+  const unsigned nof_classes = GetParam();
+
+  /* Step 1 */
+  Stopwatch stopwatch;
+  unsigned registered = RegisterClasses(nof_classes);
+  uint64_t registration = stopwatch.ElapsedNs();
+  ASSERT_EQ(nof_classes, registered);
+  perf_report::Record("classes", registered);
+  perf_report::Record("registration", registration, "ns");
+
+  for (size_t size : sizes) {
+    /* Step 2 */
+    LatencyStats stats;
+    ASSERT_EQ(0, MeasureAlloc(size, stats));
+
+    /* Step 3 */
+    perf_report::RecordLatency("alloc_" + std::to_string(size), stats);
+  }
+
+  /* Step 4 */
+  ASSERT_TRUE(OID_IS_NULL(pmemobj_first(pop)));
+}
+
+INSTANTIATE_TEST_CASE_P(AllocClassCount, PmemobjAllocClassCountPerfParamTest,
+                        ::testing::Values(0u, 16u, 64u, 127u));
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "atomic_list.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+void PmemobjAtomicListPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+}
+
+void PmemobjAtomicListPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjAtomicListPerfTest::CreatePool(size_t nof_elements) {
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(),
+                       GetPoolSize(nof_elements), S_IWRITE | S_IREAD);
+  if (pop == nullptr) {
+    std::cerr << "Pool creation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(list_root));
+  if (OID_IS_NULL(root_oid)) {
+    std::cerr << "Root allocation failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+  root = static_cast<list_root *>(pmemobj_direct(root_oid));
+
+  return 0;
+}
+
+int PmemobjAtomicListPerfTest::ElemConstructor(PMEMobjpool *pop, void *ptr,
+                                               void *arg) {
+  list_elem *elem = static_cast<list_elem *>(ptr);
+  elem->value = *static_cast<uint64_t *>(arg);
+  pmemobj_persist(pop, &elem->value, sizeof(elem->value));
+  return 0;
+}
+
+int PmemobjAtomicListPerfTest::InsertElements(elem_list *head,
+                                              size_t nof_elements,
+                                              LatencyStats &stats) {
+  stats.Reserve(stats.GetCount() + nof_elements);
+
+  for (uint64_t i = 0; i < nof_elements; i++) {
+    Stopwatch insert;
+    if (pmemobj_mutex_lock(pop, &root->lock) != 0) {
+      std::cerr << "Locking the list failed: " << pmemobj_errormsg()
+                << std::endl;
+      return -1;
+    }
+    PMEMoid oid = POBJ_LIST_INSERT_NEW_HEAD(pop, head, entry, sizeof(list_elem),
+                                            ElemConstructor, &i);
+    pmemobj_mutex_unlock(pop, &root->lock);
+    stats.Add(insert.ElapsedNs());
+    if (OID_IS_NULL(oid)) {
+      std::cerr << "Inserting element " << i
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int PmemobjAtomicListPerfTest::RemoveFirst(elem_list *head) {
+  int ret = -1;
+
+  if (pmemobj_mutex_lock(pop, &root->lock) != 0) {
+    return -1;
+  }
+  TOID(struct list_elem) first = POBJ_LIST_FIRST(head);
+  if (!TOID_IS_NULL(first)) {
+    ret = POBJ_LIST_REMOVE_FREE(pop, head, first, entry);
+  }
+  pmemobj_mutex_unlock(pop, &root->lock);
+
+  return ret;
+}
+
+int PmemobjAtomicListPerfTest::MoveFirst() {
+  int ret = -1;
+
+  if (pmemobj_mutex_lock(pop, &root->lock) != 0) {
+    return -1;
+  }
+  TOID(struct list_elem) first = POBJ_LIST_FIRST(&root->first);
+  if (!TOID_IS_NULL(first)) {
+    ret = POBJ_LIST_MOVE_ELEMENT_HEAD(pop, &root->first, &root->second, first,
+                                      entry, entry);
+  }
+  pmemobj_mutex_unlock(pop, &root->lock);
+
+  return ret;
+}
+
+size_t PmemobjAtomicListPerfTest::CountElements(elem_list *head) {
+  size_t count = 0;
+  TOID(struct list_elem) elem;
+
+  POBJ_LIST_FOREACH(elem, head, entry) {
+    count++;
+  }
+
+  return count;
+}
+
+void PmemobjAtomicListPerfTest::ReportResults(size_t nof_ops,
+                                              uint64_t elapsed_ns,
+                                              size_t bytes_per_op,
+                                              LatencyStats &stats) {
+  perf_report::Record("throughput", perf_report::OpsPerSec(nof_ops, elapsed_ns),
+                      "ops/s");
+  perf_report::Record("persisted_list_bytes_per_op", bytes_per_op, "B");
+  perf_report::RecordLatency("op", stats);
+}
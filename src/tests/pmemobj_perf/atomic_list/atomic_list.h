@@ -0,0 +1,141 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_ATOMIC_LIST_PERF_H
+#define PMDK_TESTS_ATOMIC_LIST_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+struct list_elem;
+TOID_DECLARE(struct list_elem, 1);
+
+struct list_elem {
+  POBJ_LIST_ENTRY(struct list_elem) entry;
+  uint64_t value;
+};
+
+POBJ_LIST_HEAD(elem_list, struct list_elem);
+
+struct list_root {
+  struct elem_list first;
+  struct elem_list second;
+  PMEMmutex lock;
+};
+
+class PmemobjAtomicListPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  list_root *root = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "atomic_list_perf";
+  /* Number of bytes of list links modified by inserting or removing an element
+   * at the head of the list: list head and links of two neighbours. */
+  const size_t links_per_op_size = 3 * sizeof(PMEMoid);
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  size_t GetPoolSize(size_t nof_elements) const {
+    /* each element occupies a single 128 B allocation unit at most */
+    return 64 * MEBIBYTE + nof_elements * 128;
+  }
+
+  /*
+   * CreatePool -- creates pool big enough to hold nof_elements list elements
+   * and allocates the root object. Returns 0 on success, prints error message
+   * and returns -1 otherwise.
+   */
+  int CreatePool(size_t nof_elements);
+
+  /*
+   * InsertElements -- inserts nof_elements new elements at the head of given
+   * list under the lock from the root object, collecting latency of each
+   * insert in stats. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  int InsertElements(elem_list *head, size_t nof_elements,
+                     LatencyStats &stats);
+
+  /*
+   * RemoveFirst -- removes and frees the first element of given list under
+   * the lock from the root object. Returns 0 on success, -1 otherwise.
+   */
+  int RemoveFirst(elem_list *head);
+
+  /*
+   * MoveFirst -- moves the first element of the first list in the root object
+   * to the head of the second list under the lock from the root object.
+   * Returns 0 on success, -1 otherwise.
+   */
+  int MoveFirst();
+
+  /*
+   * CountElements -- traverses given list and returns number of its elements.
+   */
+  size_t CountElements(elem_list *head);
+
+  void ReportResults(size_t nof_ops, uint64_t elapsed_ns, size_t bytes_per_op,
+                     LatencyStats &stats);
+
+  static int ElemConstructor(PMEMobjpool *pop, void *ptr, void *arg);
+};
+
+class PmemobjAtomicListPerfParamTest
+    : public PmemobjAtomicListPerfTest,
+      public ::testing::WithParamInterface<size_t> {
+ protected:
+  const size_t max_ops = 100000;
+};
+
+class PmemobjAtomicListMtPerfParamTest
+    : public PmemobjAtomicListPerfTest,
+      public ::testing::WithParamInterface<size_t> {
+ protected:
+  const size_t list_length = 100000;
+  const size_t ops_per_thread = 10000;
+};
+
+#endif  // PMDK_TESTS_ATOMIC_LIST_PERF_H
@@ -0,0 +1,344 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <algorithm>
+#include <future>
+#include "atomic_list.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "perf/stopwatch.h"
+
+/**
+ * ATOMIC_LIST_INSERT
+ * Parameterized Test Case: Measures throughput and latency of inserting new
+ * elements at the head of the atomic list with POBJ_LIST_INSERT_NEW_HEAD until
+ * the list reaches given length (n)
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Insert n elements with POBJ_LIST_INSERT_NEW_HEAD
+ *          / SUCCESS
+ *          \li \c Step3. Verify that the list consists of n elements
+ *          \li \c Step4. Report throughput, latency and persisted bytes per
+ *          insert
+ */
+TEST_P(PmemobjAtomicListPerfParamTest, ATOMIC_LIST_INSERT) {
+  const size_t list_length = GetParam();
+  LatencyStats stats;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), GetPoolSize(list_length))) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(list_length));
+
+  /* Step 2 */
+  Stopwatch total;
+  ASSERT_EQ(0, InsertElements(&root->first, list_length, stats));
+  uint64_t elapsed = total.ElapsedNs();
+
+  /* Step 3 */
+  ASSERT_EQ(list_length, CountElements(&root->first));
+
+  /* Step 4 */
+  size_t elem_size =
+      pmemobj_alloc_usable_size(POBJ_LIST_FIRST(&root->first).oid);
+  perf_report::Record("list_length", list_length);
+  ReportResults(list_length, elapsed, elem_size + links_per_op_size, stats);
+}
+
+/**
+ * ATOMIC_LIST_TRAVERSE
+ * Parameterized Test Case: Measures time of traversing the whole atomic list
+ * of given length (n) with POBJ_LIST_FOREACH
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Insert n elements with POBJ_LIST_INSERT_NEW_HEAD
+ *          / SUCCESS
+ *          \li \c Step3. Traverse the list and verify that it consists of n
+ *          elements
+ *          \li \c Step4. Report traversal time in total and per element
+ */
+TEST_P(PmemobjAtomicListPerfParamTest, ATOMIC_LIST_TRAVERSE) {
+  const size_t list_length = GetParam();
+  LatencyStats stats;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), GetPoolSize(list_length))) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(list_length));
+
+  /* Step 2 */
+  ASSERT_EQ(0, InsertElements(&root->first, list_length, stats));
+
+  /* Step 3 */
+  Stopwatch traversal;
+  size_t count = CountElements(&root->first);
+  uint64_t elapsed = traversal.ElapsedNs();
+  ASSERT_EQ(list_length, count);
+
+  /* Step 4 */
+  perf_report::Record("list_length", list_length);
+  perf_report::Record("traversal_time", elapsed, "ns");
+  perf_report::Record("traversal_time_per_element",
+                      static_cast<double>(elapsed) / list_length, "ns");
+}
+
+/**
+ * ATOMIC_LIST_REMOVE
+ * Parameterized Test Case: Measures throughput and latency of removing
+ * elements from the head of the atomic list of given length (n) with
+ * POBJ_LIST_REMOVE_FREE
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Insert n elements with POBJ_LIST_INSERT_NEW_HEAD
+ *          / SUCCESS
+ *          \li \c Step3. Remove k = min(n, 100000) first elements with
+ *          POBJ_LIST_REMOVE_FREE / SUCCESS
+ *          \li \c Step4. Verify that the list consists of n - k elements
+ *          \li \c Step5. Report throughput, latency and persisted bytes per
+ *          remove
+ */
+TEST_P(PmemobjAtomicListPerfParamTest, ATOMIC_LIST_REMOVE) {
+  const size_t list_length = GetParam();
+  const size_t nof_ops = std::min(list_length, max_ops);
+  LatencyStats insert_stats;
+  LatencyStats stats;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), GetPoolSize(list_length))) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(list_length));
+
+  /* Step 2 */
+  ASSERT_EQ(0, InsertElements(&root->first, list_length, insert_stats));
+
+  /* Step 3 */
+  stats.Reserve(nof_ops);
+  Stopwatch total;
+  for (size_t i = 0; i < nof_ops; i++) {
+    Stopwatch remove;
+    ASSERT_EQ(0, RemoveFirst(&root->first)) << pmemobj_errormsg();
+    stats.Add(remove.ElapsedNs());
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  /* Step 4 */
+  ASSERT_EQ(list_length - nof_ops, CountElements(&root->first));
+
+  /* Step 5 */
+  perf_report::Record("list_length", list_length);
+  ReportResults(nof_ops, elapsed, links_per_op_size, stats);
+}
+
+/**
+ * ATOMIC_LIST_MOVE
+ * Parameterized Test Case: Measures throughput and latency of moving elements
+ * between two atomic lists with pmemobj_list_move, when the source list has
+ * given length (n)
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Insert n elements to the first list with
+ *          POBJ_LIST_INSERT_NEW_HEAD / SUCCESS
+ *          \li \c Step3. Move k = min(n, 100000) first elements to the head of
+ *          the second list with POBJ_LIST_MOVE_ELEMENT_HEAD / SUCCESS
+ *          \li \c Step4. Verify that the first list consists of n - k elements
+ *          and the second one of k elements
+ *          \li \c Step5. Report throughput, latency and persisted bytes per
+ *          move
+ */
+TEST_P(PmemobjAtomicListPerfParamTest, ATOMIC_LIST_MOVE) {
+  const size_t list_length = GetParam();
+  const size_t nof_ops = std::min(list_length, max_ops);
+  LatencyStats insert_stats;
+  LatencyStats stats;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), GetPoolSize(list_length))) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(list_length));
+
+  /* Step 2 */
+  ASSERT_EQ(0, InsertElements(&root->first, list_length, insert_stats));
+
+  /* Step 3 */
+  stats.Reserve(nof_ops);
+  Stopwatch total;
+  for (size_t i = 0; i < nof_ops; i++) {
+    Stopwatch move;
+    ASSERT_EQ(0, MoveFirst()) << pmemobj_errormsg();
+    stats.Add(move.ElapsedNs());
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  /* Step 4 */
+  ASSERT_EQ(list_length - nof_ops, CountElements(&root->first));
+  ASSERT_EQ(nof_ops, CountElements(&root->second));
+
+  /* Step 5 */
+  perf_report::Record("list_length", list_length);
+  ReportResults(nof_ops, elapsed, 2 * links_per_op_size, stats);
+}
+
+/**
+ * ATOMIC_LIST_MT_INSERT_REMOVE
+ * Parameterized Test Case: Measures throughput and latency of inserting and
+ * removing elements of a single atomic list by given number of threads (n),
+ * where inserts and removals are protected by the lock from the root object
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Insert 100000 elements with POBJ_LIST_INSERT_NEW_HEAD
+ *          / SUCCESS
+ *          \li \c Step3. Insert a new element and remove the first element
+ *          repeatedly using n threads / SUCCESS
+ *          \li \c Step4. Synchronize the threads
+ *          \li \c Step5. Verify that the list consists of 100000 elements
+ *          \li \c Step6. Report throughput and latency
+ */
+TEST_P(PmemobjAtomicListMtPerfParamTest, ATOMIC_LIST_MT_INSERT_REMOVE) {
+  const size_t nof_threads = GetParam();
+  std::vector<std::future<LatencyStats>> future_stats;
+  LatencyStats stats;
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(list_length));
+
+  /* Step 2 */
+  ASSERT_EQ(0, InsertElements(&root->first, list_length, stats));
+  stats = LatencyStats();
+
+  /* Step 3 */
+  Stopwatch total;
+  for (size_t th = 0; th < nof_threads; th++) {
+    future_stats.push_back(std::async(std::launch::async, [this]() {
+      LatencyStats thread_stats;
+      LatencyStats insert_stats;
+      for (size_t i = 0; i < ops_per_thread; i++) {
+        Stopwatch op;
+        EXPECT_EQ(0, InsertElements(&root->first, 1, insert_stats));
+        EXPECT_EQ(0, RemoveFirst(&root->first)) << pmemobj_errormsg();
+        thread_stats.Add(op.ElapsedNs());
+      }
+      return thread_stats;
+    }));
+  }
+
+  /* Step 4 */
+  for (auto &future_stat : future_stats) {
+    stats.Merge(future_stat.get());
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  /* Step 5 */
+  ASSERT_EQ(list_length, CountElements(&root->first));
+
+  /* Step 6 */
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("throughput",
+                      perf_report::OpsPerSec(2 * nof_threads * ops_per_thread,
+                                             elapsed),
+                      "ops/s");
+  perf_report::RecordLatency("op", stats);
+}
+
+/**
+ * ATOMIC_LIST_MT_MOVE
+ * Parameterized Test Case: Measures throughput and latency of moving elements
+ * between two atomic lists by given number of threads (n) under the lock from
+ * the root object
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Insert 100000 elements to the first list with
+ *          POBJ_LIST_INSERT_NEW_HEAD / SUCCESS
+ *          \li \c Step3. Move the first element to the second list repeatedly
+ *          using n threads / SUCCESS
+ *          \li \c Step4. Synchronize the threads
+ *          \li \c Step5. Verify that all moved elements are in the second list
+ *          \li \c Step6. Report throughput and latency
+ */
+TEST_P(PmemobjAtomicListMtPerfParamTest, ATOMIC_LIST_MT_MOVE) {
+  const size_t nof_threads = GetParam();
+  const size_t nof_moves = nof_threads * ops_per_thread;
+  std::vector<std::future<LatencyStats>> future_stats;
+  LatencyStats stats;
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(list_length));
+
+  /* Step 2 */
+  ASSERT_EQ(0, InsertElements(&root->first, list_length, stats));
+  stats = LatencyStats();
+
+  /* Step 3 */
+  Stopwatch total;
+  for (size_t th = 0; th < nof_threads; th++) {
+    future_stats.push_back(std::async(std::launch::async, [this]() {
+      LatencyStats thread_stats;
+      for (size_t i = 0; i < ops_per_thread; i++) {
+        Stopwatch move;
+        EXPECT_EQ(0, MoveFirst()) << pmemobj_errormsg();
+        thread_stats.Add(move.ElapsedNs());
+      }
+      return thread_stats;
+    }));
+  }
+
+  /* Step 4 */
+  for (auto &future_stat : future_stats) {
+    stats.Merge(future_stat.get());
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  /* Step 5 */
+  ASSERT_EQ(list_length - nof_moves, CountElements(&root->first));
+  ASSERT_EQ(nof_moves, CountElements(&root->second));
+
+  /* Step 6 */
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("throughput", perf_report::OpsPerSec(nof_moves, elapsed),
+                      "ops/s");
+  perf_report::RecordLatency("op", stats);
+}
+
+INSTANTIATE_TEST_CASE_P(AtomicListPerfParam, PmemobjAtomicListPerfParamTest,
+                        ::testing::Values(1000, 10000, 100000, 1000000,
+                                          10000000));
+
+INSTANTIATE_TEST_CASE_P(AtomicListMtPerfParam, PmemobjAtomicListMtPerfParamTest,
+                        ::testing::Values(1, 2, 4, 8));
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "defer_free.h"
+#include "perf/perf_report.h"
+
+void PmemobjDeferFreePerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjDeferFreePerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+std::vector<std::vector<PMEMoid>> PmemobjDeferFreePerfTest::AllocateObjects(
+    size_t nof_threads) {
+  std::vector<std::vector<PMEMoid>> objects(
+      nof_threads, std::vector<PMEMoid>(objects_per_thread, OID_NULL));
+
+  for (auto &thread_objects : objects) {
+    for (auto &oid : thread_objects) {
+      EXPECT_EQ(0, pmemobj_alloc(pop, &oid, object_size, 0, nullptr, nullptr))
+          << pmemobj_errormsg();
+    }
+  }
+
+  return objects;
+}
+
+void PmemobjDeferFreePerfTest::ReportResults(size_t nof_threads,
+                                             size_t nof_commits,
+                                             uint64_t elapsed_ns) {
+  size_t nof_frees = nof_threads * objects_per_thread;
+
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("throughput",
+                      perf_report::OpsPerSec(nof_frees, elapsed_ns), "frees/s");
+  perf_report::Record("commits", nof_commits);
+  perf_report::Record("frees_per_commit",
+                      static_cast<double>(nof_frees) / nof_commits);
+}
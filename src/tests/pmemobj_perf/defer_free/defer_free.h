@@ -0,0 +1,115 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_DEFER_FREE_PERF_H
+#define PMDK_TESTS_DEFER_FREE_PERF_H
+
+#include <libpmemobj.h>
+#include <future>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/stopwatch.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjDeferFreePerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "defer_free_perf";
+  const size_t pool_size = 512 * MEBIBYTE;
+  const size_t object_size = 256;
+  const size_t objects_per_thread = 20000;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * AllocateObjects -- allocates objects_per_thread objects for each of
+   * nof_threads threads. Returns vector of allocated objects per thread.
+   */
+  std::vector<std::vector<PMEMoid>> AllocateObjects(size_t nof_threads);
+
+  /*
+   * RunFrees -- frees given objects calling free_objects in a separate thread
+   * for each vector of objects. Threads are released at the same time.
+   * Returns total execution time in nanoseconds.
+   */
+  template <typename FreeObjects>
+  uint64_t RunFrees(std::vector<std::vector<PMEMoid>> &objects,
+                    FreeObjects free_objects);
+
+  void ReportResults(size_t nof_threads, size_t nof_commits,
+                     uint64_t elapsed_ns);
+};
+
+class PmemobjDeferFreePerfParamTest
+    : public PmemobjDeferFreePerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+class PmemobjDeferFreeBatchPerfParamTest
+    : public PmemobjDeferFreePerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
+
+template <typename FreeObjects>
+uint64_t PmemobjDeferFreePerfTest::RunFrees(
+    std::vector<std::vector<PMEMoid>> &objects, FreeObjects free_objects) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<int>> future_rets;
+
+  for (auto &thread_objects : objects) {
+    future_rets.push_back(
+        std::async(std::launch::async, [&thread_objects, &free_objects,
+                                        started]() {
+          started.wait();
+          return free_objects(thread_objects);
+        }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &future_ret : future_rets) {
+    EXPECT_EQ(0, future_ret.get()) << pmemobj_errormsg();
+  }
+  return total.ElapsedNs();
+}
+
+#endif  // PMDK_TESTS_DEFER_FREE_PERF_H
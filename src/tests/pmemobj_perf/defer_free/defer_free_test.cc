@@ -0,0 +1,218 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <algorithm>
+#include "defer_free.h"
+#include "perf/perf_utils.h"
+
+/**
+ * DEFER_FREE_INDIVIDUAL_FREE
+ * Parameterized Test Case: Measures throughput of freeing objects with
+ * individual pmemobj_free calls by given number of threads (n)
+ * \test
+ *          \li \c Step1. Allocate 20000 objects per thread / SUCCESS
+ *          \li \c Step2. Free all objects with pmemobj_free using n threads
+ *          / SUCCESS
+ *          \li \c Step3. Verify that no objects are left in the pool
+ *          \li \c Step4. Report throughput and number of commits
+ */
+TEST_P(PmemobjDeferFreePerfParamTest, DEFER_FREE_INDIVIDUAL_FREE) {
+  const size_t nof_threads = GetParam();
+
+  /* Step 1 */
+  auto objects = AllocateObjects(nof_threads);
+
+  /* Step 2 */
+  uint64_t elapsed = RunFrees(objects, [](std::vector<PMEMoid> &oids) {
+    for (auto &oid : oids) {
+      pmemobj_free(&oid);
+    }
+    return 0;
+  });
+
+  /* Step 3 */
+  ASSERT_EQ(0, perf_utils::CountObjects(pop));
+
+  /* Step 4 */
+  ReportResults(nof_threads, nof_threads * objects_per_thread, elapsed);
+}
+
+/**
+ * DEFER_FREE_SINGLE_TX
+ * Parameterized Test Case: Measures throughput of freeing objects with
+ * pmemobj_tx_free calls inside a single transaction per thread by given number
+ * of threads (n)
+ * \test
+ *          \li \c Step1. Allocate 20000 objects per thread / SUCCESS
+ *          \li \c Step2. Free all objects of each thread in one transaction
+ *          with pmemobj_tx_free using n threads / SUCCESS
+ *          \li \c Step3. Verify that no objects are left in the pool
+ *          \li \c Step4. Report throughput and number of commits
+ */
+TEST_P(PmemobjDeferFreePerfParamTest, DEFER_FREE_SINGLE_TX) {
+  const size_t nof_threads = GetParam();
+
+  /* Step 1 */
+  auto objects = AllocateObjects(nof_threads);
+
+  /* Step 2 */
+  uint64_t elapsed = RunFrees(objects, [this](std::vector<PMEMoid> &oids) {
+    int ret = 0;
+    TX_BEGIN(pop) {
+      for (auto &oid : oids) {
+        pmemobj_tx_free(oid);
+      }
+    }
+    TX_ONABORT {
+      ret = -1;
+    }
+    TX_END
+    return ret;
+  });
+
+  /* Step 3 */
+  ASSERT_EQ(0, perf_utils::CountObjects(pop));
+
+  /* Step 4 */
+  ReportResults(nof_threads, nof_threads, elapsed);
+}
+
+/**
+ * DEFER_FREE_PUBLISH_BATCHED
+ * Parameterized Test Case: Measures throughput of freeing objects with
+ * pmemobj_defer_free actions published in batches. Parameters are:
+ *  - the number of threads (n)
+ *  - the number of actions published at once (b)
+ * \test
+ *          \li \c Step1. Allocate 20000 objects per thread / SUCCESS
+ *          \li \c Step2. Mark objects to be freed with pmemobj_defer_free and
+ *          publish every b actions with pmemobj_publish using n threads
+ *          / SUCCESS
+ *          \li \c Step3. Verify that no objects are left in the pool
+ *          \li \c Step4. Report throughput and number of commits
+ */
+TEST_P(PmemobjDeferFreeBatchPerfParamTest, DEFER_FREE_PUBLISH_BATCHED) {
+  const size_t nof_threads = std::get<0>(GetParam());
+  const size_t batch_size = std::get<1>(GetParam());
+
+  /* Step 1 */
+  auto objects = AllocateObjects(nof_threads);
+
+  /* Step 2 */
+  uint64_t elapsed =
+      RunFrees(objects, [this, batch_size](std::vector<PMEMoid> &oids) {
+        std::vector<pobj_action> actions;
+        actions.reserve(batch_size);
+        for (auto &oid : oids) {
+          actions.emplace_back();
+          pmemobj_defer_free(pop, oid, &actions.back());
+          if (actions.size() == batch_size) {
+            if (pmemobj_publish(pop, actions.data(), actions.size()) != 0) {
+              return -1;
+            }
+            actions.clear();
+          }
+        }
+        if (!actions.empty()) {
+          return pmemobj_publish(pop, actions.data(), actions.size());
+        }
+        return 0;
+      });
+
+  /* Step 3 */
+  ASSERT_EQ(0, perf_utils::CountObjects(pop));
+
+  /* Step 4 */
+  size_t commits_per_thread =
+      (objects_per_thread + batch_size - 1) / batch_size;
+  ReportResults(nof_threads, nof_threads * commits_per_thread, elapsed);
+}
+
+/**
+ * DEFER_FREE_TX_BATCHED
+ * Parameterized Test Case: Measures throughput of freeing objects with
+ * pmemobj_tx_free calls in many small transactions. Parameters are:
+ *  - the number of threads (n)
+ *  - the number of objects freed in one transaction (b)
+ * \test
+ *          \li \c Step1. Allocate 20000 objects per thread / SUCCESS
+ *          \li \c Step2. Free objects with pmemobj_tx_free, b objects per
+ *          transaction, using n threads / SUCCESS
+ *          \li \c Step3. Verify that no objects are left in the pool
+ *          \li \c Step4. Report throughput and number of commits
+ */
+TEST_P(PmemobjDeferFreeBatchPerfParamTest, DEFER_FREE_TX_BATCHED) {
+  const size_t nof_threads = std::get<0>(GetParam());
+  const size_t batch_size = std::get<1>(GetParam());
+
+  /* Step 1 */
+  auto objects = AllocateObjects(nof_threads);
+
+  /* Step 2 */
+  uint64_t elapsed =
+      RunFrees(objects, [this, batch_size](std::vector<PMEMoid> &oids) {
+        for (size_t i = 0; i < oids.size(); i += batch_size) {
+          int ret = 0;
+          size_t batch_end = std::min(i + batch_size, oids.size());
+          TX_BEGIN(pop) {
+            for (size_t j = i; j < batch_end; j++) {
+              pmemobj_tx_free(oids[j]);
+            }
+          }
+          TX_ONABORT {
+            ret = -1;
+          }
+          TX_END
+          if (ret != 0) {
+            return ret;
+          }
+        }
+        return 0;
+      });
+
+  /* Step 3 */
+  ASSERT_EQ(0, perf_utils::CountObjects(pop));
+
+  /* Step 4 */
+  size_t commits_per_thread =
+      (objects_per_thread + batch_size - 1) / batch_size;
+  ReportResults(nof_threads, nof_threads * commits_per_thread, elapsed);
+}
+
+INSTANTIATE_TEST_CASE_P(DeferFreePerfParam, PmemobjDeferFreePerfParamTest,
+                        ::testing::Values(1, 4, 8));
+
+INSTANTIATE_TEST_CASE_P(
+    DeferFreeBatchPerfParam, PmemobjDeferFreeBatchPerfParamTest,
+    ::testing::Combine(::testing::Values(1, 4, 8),
+                       ::testing::Values(1, 16, 256, 4096)));
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "defrag.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include "perf/stopwatch.h"
+
+void PmemobjDefragPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+
+  PMEMoid root = pmemobj_root(pop, nof_objects * sizeof(PMEMoid));
+  ASSERT_FALSE(OID_IS_NULL(root)) << pmemobj_errormsg();
+  objects = static_cast<PMEMoid *>(pmemobj_direct(root));
+
+  enum pobj_stats_enabled stats_enabled = POBJ_STATS_ENABLED_TRANSIENT;
+  ASSERT_EQ(0, pmemobj_ctl_set(pop, "stats.enabled", &stats_enabled))
+      << pmemobj_errormsg();
+}
+
+void PmemobjDefragPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjDefragPerfTest::Populate() {
+  for (uint64_t i = 0; i < nof_objects; ++i) {
+    if (pmemobj_alloc(pop, &objects[i], object_size, 0, nullptr, nullptr) !=
+        0) {
+      std::cerr << "Allocation of object " << i
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+    pmemobj_memcpy_persist(pop, pmemobj_direct(objects[i]), &i, sizeof(i));
+  }
+  return 0;
+}
+
+void PmemobjDefragPerfTest::FreeEveryOther() {
+  for (size_t i = 1; i < nof_objects; i += 2) {
+    pmemobj_free(&objects[i]);
+  }
+}
+
+double PmemobjDefragPerfTest::GetUtilisation() {
+  uint64_t run_allocated = 0;
+  uint64_t run_active = 0;
+
+  if (pmemobj_ctl_get(pop, "stats.heap.run_allocated", &run_allocated) != 0 ||
+      pmemobj_ctl_get(pop, "stats.heap.run_active", &run_active) != 0) {
+    return -1;
+  }
+
+  if (run_active == 0) {
+    return 0;
+  }
+  return static_cast<double>(run_allocated) / run_active;
+}
+
+int PmemobjDefragPerfTest::Defragment(size_t batch_size, size_t nof_threads,
+                                      size_t &relocated) {
+  std::vector<PMEMoid *> live;
+  for (size_t i = 0; i < nof_objects; ++i) {
+    if (!OID_IS_NULL(objects[i])) {
+      live.push_back(&objects[i]);
+    }
+  }
+
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<int>> future_rets;
+  std::atomic<size_t> next_batch{0};
+  std::atomic<size_t> total_relocated{0};
+
+  for (size_t i = 0; i < nof_threads; ++i) {
+    future_rets.push_back(std::async(std::launch::async, [&, started]() {
+      started.wait();
+      for (size_t begin = next_batch++ * batch_size; begin < live.size();
+           begin = next_batch++ * batch_size) {
+        size_t count = std::min(batch_size, live.size() - begin);
+        pobj_defrag_result result = {0, 0};
+        if (pmemobj_defrag(pop, live.data() + begin, count, &result) != 0) {
+          std::cerr << "Defragmentation failed: " << pmemobj_errormsg()
+                    << std::endl;
+          return -1;
+        }
+        total_relocated += result.relocated;
+      }
+      return 0;
+    }));
+  }
+
+  start.set_value();
+  int ret = 0;
+  for (auto &future_ret : future_rets) {
+    if (future_ret.get() != 0) {
+      ret = -1;
+    }
+  }
+
+  relocated = total_relocated;
+  return ret;
+}
+
+void PmemobjDefragPerfTest::RunAllocator(const std::atomic<bool> &stop,
+                                         size_t max_ops, LatencyStats &stats) {
+  for (size_t i = 0; i < max_ops && !stop; ++i) {
+    PMEMoid oid = OID_NULL;
+
+    Stopwatch stopwatch;
+    int ret = pmemobj_alloc(pop, &oid, object_size, 0, nullptr, nullptr);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+
+    if (ret == 0) {
+      stats.Add(elapsed);
+      pmemobj_free(&oid);
+    }
+  }
+}
+
+bool PmemobjDefragPerfTest::Verify() const {
+  for (uint64_t i = 0; i < nof_objects; ++i) {
+    if (OID_IS_NULL(objects[i])) {
+      continue;
+    }
+    uint64_t index;
+    memcpy(&index, pmemobj_direct(objects[i]), sizeof(index));
+    if (index != i) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_DEFRAG_PERF_H
+#define PMDK_TESTS_DEFRAG_PERF_H
+
+#include <libpmemobj.h>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjDefragPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  /* array of object handles stored in the root object */
+  PMEMoid *objects = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "defrag_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  const size_t nof_objects = 200000;
+  const size_t object_size = 256;
+  /* number of allocations measured before defragmentation */
+  const size_t nof_baseline_ops = 10000;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * Populate -- allocates nof_objects objects storing their handles in the
+   * root object and writes index of each object to its first 8 bytes.
+   * Returns 0 on success, prints error message and returns -1 otherwise.
+   */
+  int Populate();
+
+  /*
+   * FreeEveryOther -- frees objects with odd indexes, leaving half of each
+   * run unused.
+   */
+  void FreeEveryOther();
+
+  /*
+   * GetUtilisation -- returns fraction of memory in active runs that is
+   * allocated, calculated from heap statistics. Returns -1 if statistics are
+   * not supported by libpmemobj.
+   */
+  double GetUtilisation();
+
+  /*
+   * Defragment -- calls pmemobj_defrag on batches of batch_size live objects
+   * using nof_threads threads, each thread taking next batch until all
+   * objects are processed. Stores total number of relocated objects in
+   * relocated. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  int Defragment(size_t batch_size, size_t nof_threads, size_t &relocated);
+
+  /*
+   * RunAllocator -- allocates and frees object of object_size until stop is
+   * set or max_ops operations are done, collecting allocation latency.
+   */
+  void RunAllocator(const std::atomic<bool> &stop, size_t max_ops,
+                    LatencyStats &stats);
+
+  /*
+   * Verify -- checks that all live objects hold their indexes.
+   */
+  bool Verify() const;
+};
+
+class PmemobjDefragPerfParamTest
+    : public PmemobjDefragPerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
+
+#endif  // PMDK_TESTS_DEFRAG_PERF_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cstdint>
+#include <future>
+#include "defrag.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+/**
+ * DEFRAG
+ * Parameterized Test Case: Measures throughput of pmemobj_defrag on a
+ * fragmented heap, utilisation gained and latency of allocations performed
+ * concurrently with defragmentation. Parameters are number of objects passed
+ * to a single pmemobj_defrag call (b) and number of defragmenting threads
+ * (t)
+ * \test
+ *          \li \c Step1. Allocate 200000 objects of 256 B storing their
+ *          handles in the root object / SUCCESS
+ *          \li \c Step2. Free objects with odd indexes / SUCCESS
+ *          \li \c Step3. Measure latency of 10000 allocations and frees as a
+ *          baseline
+ *          \li \c Step4. Defragment live objects in batches of b objects
+ *          using t threads, while another thread allocates and frees objects
+ *          measuring allocation latency / SUCCESS
+ *          \li \c Step5. Verify that all live objects hold their indexes
+ *          \li \c Step6. Report relocated objects per second, utilisation of
+ *          active runs before and after defragmentation and allocation
+ *          latency during defragmentation compared with the baseline
+ */
+TEST_P(PmemobjDefragPerfParamTest, DEFRAG) {
+  const size_t batch_size = std::get<0>(GetParam());
+  const size_t nof_threads = std::get<1>(GetParam());
+  LatencyStats baseline_stats;
+  LatencyStats concurrent_stats;
+  std::atomic<bool> stop{false};
+  size_t relocated = 0;
+
+  /* Step 1 */
+  ASSERT_EQ(0, Populate());
+
+  /* Step 2 */
+  FreeEveryOther();
+  double utilisation_before = GetUtilisation();
+
+  /* Step 3 */
+  RunAllocator(stop, nof_baseline_ops, baseline_stats);
+
+  /* Step 4 */
+  auto allocator = std::async(std::launch::async, [&]() {
+    RunAllocator(stop, SIZE_MAX, concurrent_stats);
+  });
+  Stopwatch stopwatch;
+  int ret = Defragment(batch_size, nof_threads, relocated);
+  uint64_t elapsed = stopwatch.ElapsedNs();
+  stop = true;
+  allocator.get();
+  ASSERT_EQ(0, ret);
+
+  /* Step 5 */
+  ASSERT_TRUE(Verify());
+
+  /* Step 6 */
+  double utilisation_after = GetUtilisation();
+  perf_report::Record("batch_size", batch_size);
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("relocated", relocated);
+  perf_report::Record("defrag_time", elapsed, "ns");
+  perf_report::Record("relocation_throughput",
+                      perf_report::OpsPerSec(relocated, elapsed), "objects/s");
+  perf_report::Record("utilisation_before", utilisation_before);
+  perf_report::Record("utilisation_after", utilisation_after);
+  perf_report::Record("utilisation_gain",
+                      utilisation_after - utilisation_before);
+  perf_report::RecordLatency("baseline_alloc", baseline_stats);
+  perf_report::RecordLatency("concurrent_alloc", concurrent_stats);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Defrag, PmemobjDefragPerfParamTest,
+    ::testing::Combine(::testing::Values(16, 256, 4096, 65536),
+                       ::testing::Values(1, 2, 4)));
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "flush_coalescing.h"
+#include <cstdint>
+#include <cstring>
+
+void PmemobjFlushCoalescingPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjFlushCoalescingPerfTest::CreatePool(size_t object_size) {
+  const size_t region_size = nof_objects * object_size;
+
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(),
+                       64 * MEBIBYTE + region_size, S_IWRITE | S_IREAD);
+  if (pop == nullptr) {
+    std::cerr << "Pool creation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  PMEMoid oid = OID_NULL;
+  if (pmemobj_zalloc(pop, &oid, region_size + cache_line_size, 0) != 0) {
+    std::cerr << "Allocation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+  /* align objects to cache line */
+  uintptr_t addr = reinterpret_cast<uintptr_t>(pmemobj_direct(oid));
+  objects = reinterpret_cast<char *>((addr + cache_line_size - 1) &
+                                     ~(cache_line_size - 1));
+
+  return 0;
+}
+
+bool PmemobjFlushCoalescingPerfTest::IsValid(FieldSpacing spacing,
+                                             size_t nof_fields,
+                                             size_t field_size) const {
+  switch (spacing) {
+    case FieldSpacing::SAME_LINE:
+      return nof_fields * field_size <= cache_line_size;
+    case FieldSpacing::SAME_BLOCK:
+      return nof_fields * field_size <= block_size;
+    case FieldSpacing::SCATTERED:
+      return field_size <= scatter_distance;
+  }
+  return false;
+}
+
+size_t PmemobjFlushCoalescingPerfTest::GetObjectSize(FieldSpacing spacing,
+                                                     size_t nof_fields) const {
+  switch (spacing) {
+    case FieldSpacing::SAME_LINE:
+      return cache_line_size;
+    case FieldSpacing::SAME_BLOCK:
+      return block_size;
+    case FieldSpacing::SCATTERED:
+      return nof_fields * scatter_distance;
+  }
+  return 0;
+}
+
+size_t PmemobjFlushCoalescingPerfTest::GetFieldOffset(FieldSpacing spacing,
+                                                      size_t nof_fields,
+                                                      size_t index) const {
+  switch (spacing) {
+    case FieldSpacing::SAME_LINE:
+      return index * (cache_line_size / nof_fields);
+    case FieldSpacing::SAME_BLOCK:
+      return index * (block_size / nof_fields);
+    case FieldSpacing::SCATTERED:
+      return index * scatter_distance;
+  }
+  return 0;
+}
+
+size_t PmemobjFlushCoalescingPerfTest::UpdateObject(
+    char *object, PersistMode mode, FieldSpacing spacing, size_t nof_fields,
+    size_t field_size, char value) {
+  size_t nof_fences = 0;
+
+  for (size_t i = 0; i < nof_fields; ++i) {
+    char *field = object + GetFieldOffset(spacing, nof_fields, i);
+    memset(field, value, field_size);
+    if (mode == PersistMode::PERSIST_PER_FIELD) {
+      pmemobj_persist(pop, field, field_size);
+      nof_fences++;
+    } else if (mode == PersistMode::FLUSH_DRAIN) {
+      pmemobj_flush(pop, field, field_size);
+    }
+  }
+
+  if (mode == PersistMode::FLUSH_DRAIN) {
+    pmemobj_drain(pop);
+    nof_fences++;
+  } else if (mode == PersistMode::MERGED) {
+    size_t last = GetFieldOffset(spacing, nof_fields, nof_fields - 1);
+    pmemobj_persist(pop, object, last + field_size);
+    nof_fences++;
+  }
+
+  return nof_fences;
+}
+
+bool PmemobjFlushCoalescingPerfTest::VerifyObject(const char *object,
+                                                  FieldSpacing spacing,
+                                                  size_t nof_fields,
+                                                  size_t field_size,
+                                                  char value) const {
+  for (size_t i = 0; i < nof_fields; ++i) {
+    const char *field = object + GetFieldOffset(spacing, nof_fields, i);
+    for (size_t j = 0; j < field_size; ++j) {
+      if (field[j] != value) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::string PmemobjFlushCoalescingPerfTest::ToString(PersistMode mode) const {
+  switch (mode) {
+    case PersistMode::PERSIST_PER_FIELD:
+      return "persist_per_field";
+    case PersistMode::FLUSH_DRAIN:
+      return "flush_drain";
+    case PersistMode::MERGED:
+      return "merged";
+  }
+  return "";
+}
+
+std::string PmemobjFlushCoalescingPerfTest::ToString(
+    FieldSpacing spacing) const {
+  switch (spacing) {
+    case FieldSpacing::SAME_LINE:
+      return "same_line";
+    case FieldSpacing::SAME_BLOCK:
+      return "same_block";
+    case FieldSpacing::SCATTERED:
+      return "scattered";
+  }
+  return "";
+}
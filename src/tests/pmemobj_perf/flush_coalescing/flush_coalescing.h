@@ -0,0 +1,120 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_FLUSH_COALESCING_PERF_H
+#define PMDK_TESTS_FLUSH_COALESCING_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * PersistMode -- way of persisting fields updated in an object:
+ *  - PERSIST_PER_FIELD - pmemobj_persist after each field
+ *  - FLUSH_DRAIN - pmemobj_flush after each field and single pmemobj_drain
+ *  - MERGED - single pmemobj_persist of range covering all fields
+ */
+enum class PersistMode { PERSIST_PER_FIELD, FLUSH_DRAIN, MERGED };
+
+/*
+ * FieldSpacing -- placement of updated fields in an object:
+ *  - SAME_LINE - fields packed in a single 64 B cache line
+ *  - SAME_BLOCK - fields spread evenly over a 256 B block
+ *  - SCATTERED - fields placed 4 KiB apart
+ */
+enum class FieldSpacing { SAME_LINE, SAME_BLOCK, SCATTERED };
+
+class PmemobjFlushCoalescingPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  char *objects = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "flush_coalescing_perf";
+  const size_t cache_line_size = 64;
+  const size_t block_size = 256;
+  const size_t scatter_distance = 4 * KIBIBYTE;
+  const size_t nof_objects = 1024;
+  const size_t nof_updates = 1000000;
+
+ public:
+  void TearDown() override;
+
+  /*
+   * CreatePool -- creates pool and allocates cache line aligned region
+   * holding nof_objects objects of given size. Returns 0 on success, prints
+   * error message and returns -1 otherwise.
+   */
+  int CreatePool(size_t object_size);
+
+  /*
+   * VerifyObject -- checks that all fields of the object are equal to value.
+   */
+  bool VerifyObject(const char *object, FieldSpacing spacing,
+                    size_t nof_fields, size_t field_size, char value) const;
+
+  /*
+   * IsValid -- checks that nof_fields fields of given size fit in the area
+   * defined by spacing.
+   */
+  bool IsValid(FieldSpacing spacing, size_t nof_fields,
+               size_t field_size) const;
+
+  size_t GetObjectSize(FieldSpacing spacing, size_t nof_fields) const;
+  size_t GetFieldOffset(FieldSpacing spacing, size_t nof_fields,
+                        size_t index) const;
+
+  /*
+   * UpdateObject -- writes value to nof_fields fields of given size in the
+   * object and persists them according to mode. Returns number of fences
+   * (drains) issued.
+   */
+  size_t UpdateObject(char *object, PersistMode mode, FieldSpacing spacing,
+                      size_t nof_fields, size_t field_size, char value);
+
+  std::string ToString(PersistMode mode) const;
+  std::string ToString(FieldSpacing spacing) const;
+};
+
+class PmemobjFlushCoalescingPerfParamTest
+    : public PmemobjFlushCoalescingPerfTest,
+      public ::testing::WithParamInterface<
+          std::tuple<PersistMode, FieldSpacing, size_t, size_t>> {};
+
+#endif  // PMDK_TESTS_FLUSH_COALESCING_PERF_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "flush_coalescing.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+/**
+ * FLUSH_COALESCING
+ * Parameterized Test Case: Measures throughput of updating given number (k)
+ * of small fields of given size (f) in an object. Parameters are:
+ *  - the way of persisting the fields (m): pmemobj_persist per field,
+ *  pmemobj_flush per field followed by single pmemobj_drain or single
+ *  pmemobj_persist of merged range
+ *  - the placement of fields (s): in a single cache line, in a 256 B block or
+ *  4 KiB apart
+ *  - the number of fields (k)
+ *  - the size of a field (f)
+ * \test
+ *          \li \c Step1. Skip combinations in which k fields of size f do not
+ *          fit in the area defined by s
+ *          \li \c Step2. Create pool and allocate region for 1024 objects
+ *          / SUCCESS
+ *          \li \c Step3. Perform 1000000 updates of k fields of consecutive
+ *          objects, persisting them according to m
+ *          \li \c Step4. Verify fields of all objects
+ *          \li \c Step5. Report updates per second and fences per update
+ */
+TEST_P(PmemobjFlushCoalescingPerfParamTest, FLUSH_COALESCING) {
+  const PersistMode mode = std::get<0>(GetParam());
+  const FieldSpacing spacing = std::get<1>(GetParam());
+  const size_t nof_fields = std::get<2>(GetParam());
+  const size_t field_size = std::get<3>(GetParam());
+  const size_t object_size = GetObjectSize(spacing, nof_fields);
+  size_t nof_fences = 0;
+
+  /* Step 1 */
+  if (!IsValid(spacing, nof_fields, field_size)) {
+    return;
+  }
+
+  /* Step 2 */
+  ASSERT_EQ(0, CreatePool(object_size));
+
+  /* Step 3 */
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < nof_updates; ++i) {
+    char *object = objects + (i % nof_objects) * object_size;
+    nof_fences += UpdateObject(object, mode, spacing, nof_fields, field_size,
+                               static_cast<char>(i / nof_objects + 1));
+  }
+  uint64_t elapsed = stopwatch.ElapsedNs();
+
+  /* Step 4 */
+  for (size_t i = nof_updates - nof_objects; i < nof_updates; ++i) {
+    char *object = objects + (i % nof_objects) * object_size;
+    ASSERT_TRUE(VerifyObject(object, spacing, nof_fields, field_size,
+                             static_cast<char>(i / nof_objects + 1)));
+  }
+
+  /* Step 5 */
+  perf_report::Record("mode", ToString(mode));
+  perf_report::Record("spacing", ToString(spacing));
+  perf_report::Record("fields", nof_fields);
+  perf_report::Record("field_size", field_size, "B");
+  perf_report::Record("throughput",
+                      perf_report::OpsPerSec(nof_updates, elapsed),
+                      "updates/s");
+  perf_report::Record("fences_per_update",
+                      static_cast<double>(nof_fences) / nof_updates);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    FlushCoalescing, PmemobjFlushCoalescingPerfParamTest,
+    ::testing::Combine(::testing::Values(PersistMode::PERSIST_PER_FIELD,
+                                         PersistMode::FLUSH_DRAIN,
+                                         PersistMode::MERGED),
+                       ::testing::Values(FieldSpacing::SAME_LINE,
+                                         FieldSpacing::SAME_BLOCK,
+                                         FieldSpacing::SCATTERED),
+                       ::testing::Values(1, 2, 4, 8),
+                       ::testing::Values(8, 16, 64)));
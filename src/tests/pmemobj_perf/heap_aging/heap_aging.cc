@@ -0,0 +1,163 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heap_aging.h"
+#include <cerrno>
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+void PmemobjHeapAgingPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjHeapAgingPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjHeapAgingPerfTest::Allocate(RecordData &records, size_t size,
+                                       LatencyStats &alloc_stats,
+                                       LatencyStats &write_stats) {
+  pobj_action act;
+
+  Stopwatch stopwatch;
+  PMEMoid oid = records.Reserve(&act, size);
+  uint64_t alloc_ns = stopwatch.ElapsedNs();
+  if (OID_IS_NULL(oid)) {
+    if (errno == ENOMEM) {
+      return 1;
+    }
+    std::cerr << "Reservation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  stopwatch.Restart();
+  records.WriteContent(oid, size);
+  uint64_t write_ns = stopwatch.ElapsedNs();
+
+  stopwatch.Restart();
+  int ret = pmemobj_publish(pop, &act, 1);
+  alloc_ns += stopwatch.ElapsedNs();
+  if (ret != 0) {
+    pmemobj_cancel(pop, &act, 1);
+    std::cerr << "Publication failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  alloc_stats.Add(alloc_ns);
+  write_stats.Add(write_ns);
+  objects.emplace_back(oid, size);
+  live_bytes += size;
+  return 0;
+}
+
+int PmemobjHeapAgingPerfTest::Reallocate(RecordData &records, size_t size) {
+  std::uniform_int_distribution<size_t> index(0, objects.size() - 1);
+  auto &object = objects[index(generator)];
+
+  int ret = records.Rewrite(object.first, size);
+  if (ret != 0) {
+    return ret;
+  }
+
+  live_bytes = live_bytes - object.second + size;
+  object.second = size;
+  return 0;
+}
+
+void PmemobjHeapAgingPerfTest::FreeRandom() {
+  std::uniform_int_distribution<size_t> index(0, objects.size() - 1);
+  auto &object = objects[index(generator)];
+
+  pmemobj_free(&object.first);
+  live_bytes -= object.second;
+  object = objects.back();
+  objects.pop_back();
+}
+
+size_t PmemobjHeapAgingPerfTest::ProbeFreeSpace(
+    SizeDistribution &distribution) {
+  std::vector<pobj_action> actions;
+  size_t reserved = 0;
+
+  while (true) {
+    size_t size = distribution.Next();
+    actions.emplace_back();
+    if (OID_IS_NULL(pmemobj_reserve(pop, &actions.back(), size, 0))) {
+      actions.pop_back();
+      break;
+    }
+    reserved += size;
+  }
+
+  if (!actions.empty()) {
+    pmemobj_cancel(pop, actions.data(), actions.size());
+  }
+  return reserved;
+}
+
+double PmemobjHeapAgingPerfTest::GetRunFragmentation() {
+  uint64_t run_allocated = 0;
+  uint64_t run_active = 0;
+
+  if (pmemobj_ctl_get(pop, "stats.heap.run_allocated", &run_allocated) != 0 ||
+      pmemobj_ctl_get(pop, "stats.heap.run_active", &run_active) != 0) {
+    return -1;
+  }
+
+  if (run_active == 0) {
+    return 0;
+  }
+  return 1 - static_cast<double>(run_allocated) / run_active;
+}
+
+void PmemobjHeapAgingPerfTest::ReportSnapshot(size_t index,
+                                              double elapsed_sec,
+                                              size_t extra_bytes,
+                                              LatencyStats &stats) {
+  const std::string prefix = "snapshot_" + std::to_string(index);
+
+  perf_report::Record(prefix + "_elapsed", elapsed_sec, "s");
+  perf_report::Record(prefix + "_live_objects", objects.size());
+  perf_report::Record(prefix + "_live_bytes", live_bytes, "B");
+  perf_report::Record(
+      prefix + "_utilisation",
+      100.0 * static_cast<double>(live_bytes + extra_bytes) / pool_size, "%");
+  perf_report::Record(prefix + "_run_fragmentation", GetRunFragmentation());
+  perf_report::RecordLatency(prefix + "_alloc", stats);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_HEAP_AGING_PERF_H
+#define PMDK_TESTS_HEAP_AGING_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+#include "perf/size_distribution.h"
+#include "pool_data/record_data.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjHeapAgingPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "heap_aging_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  const size_t min_size = 64;
+  const size_t max_size = 16 * KIBIBYTE;
+  const size_t nof_snapshots = 10;
+  /* live objects with their requested sizes */
+  std::vector<std::pair<PMEMoid, size_t>> objects;
+  size_t live_bytes = 0;
+  std::mt19937_64 generator;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * Allocate -- reserves record of given size, writes its content and
+   * publishes it. Records latency of the reservation and publication in
+   * alloc_stats and latency of writing the content in write_stats. Returns 0
+   * on success, 1 if there is no space left in the pool, prints error message
+   * and returns -1 on any other error.
+   */
+  int Allocate(RecordData &records, size_t size, LatencyStats &alloc_stats,
+               LatencyStats &write_stats);
+
+  /*
+   * Reallocate -- reallocates randomly chosen live record to given size and
+   * rewrites its content. Returns 0 on success, 1 if there is no space left
+   * in the pool and -1 on any other error.
+   */
+  int Reallocate(RecordData &records, size_t size);
+
+  /*
+   * FreeRandom -- frees randomly chosen live object.
+   */
+  void FreeRandom();
+
+  /*
+   * ProbeFreeSpace -- reserves objects with sizes drawn from given
+   * distribution until reservation fails and cancels all reservations.
+   * Returns sum of sizes of successfully reserved objects.
+   */
+  size_t ProbeFreeSpace(SizeDistribution &distribution);
+
+  /*
+   * GetRunFragmentation -- returns fraction of memory in active runs that is
+   * not allocated, calculated from heap statistics. Returns -1 if statistics
+   * are not supported by libpmemobj.
+   */
+  double GetRunFragmentation();
+
+  void ReportSnapshot(size_t index, double elapsed_sec, size_t extra_bytes,
+                      LatencyStats &stats);
+};
+
+class PmemobjHeapAgingPerfParamTest
+    : public PmemobjHeapAgingPerfTest,
+      public ::testing::WithParamInterface<
+          std::tuple<SizeDistributionType, double>> {};
+
+#endif  // PMDK_TESTS_HEAP_AGING_PERF_H
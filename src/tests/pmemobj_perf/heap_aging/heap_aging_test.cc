@@ -0,0 +1,145 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heap_aging.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+/**
+ * HEAP_AGING_SOAK
+ * Parameterized Test Case: Ages the heap with a long-running mix of
+ * allocations, reallocations and frees and tracks how allocation latency,
+ * achievable utilisation and run fragmentation change over time. Parameters
+ * are:
+ *  - the distribution of object sizes (d) in range [64 B, 16 KiB]
+ *  - the target ratio of live bytes to the pool size (r)
+ * \test
+ *          \li \c Step1. Create pool and enable heap statistics / SUCCESS
+ *          \li \c Step2. For perfSoakDuration seconds allocate, reallocate
+ *          and free records of sizes drawn from d, allocating more often
+ *          while live bytes are below r * pool size and freeing more often
+ *          otherwise / SUCCESS
+ *          \li \c Step3. In 10 evenly spaced snapshots reserve objects until
+ *          the pool is exhausted and cancel the reservations, report
+ *          achievable utilisation, run fragmentation and allocation latency
+ *          percentiles from the last period
+ *          \li \c Step4. Verify content of all live records and free them
+ *          / SUCCESS
+ *          \li \c Step5. Verify that no objects are left in the pool
+ *          \li \c Step6. Report number of operations, failed allocations,
+ *          allocation latency percentiles of the whole run and, separately,
+ *          latency percentiles of writing record content
+ */
+TEST_P(PmemobjHeapAgingPerfParamTest, HEAP_AGING_SOAK) {
+  SizeDistribution distribution(std::get<0>(GetParam()), min_size, max_size);
+  SizeDistribution probe_distribution(std::get<0>(GetParam()), min_size,
+                                      max_size, 1);
+  const double live_ratio = std::get<1>(GetParam());
+  const size_t target_bytes = static_cast<size_t>(live_ratio * pool_size);
+  const uint64_t period_ns = local_config->GetPerfSoakDuration() *
+                             1000000000ull / nof_snapshots;
+  RecordData records(pop, distribution);
+  std::uniform_int_distribution<unsigned> operation(0, 9);
+  LatencyStats total_stats;
+  LatencyStats period_stats;
+  LatencyStats write_stats;
+  size_t nof_ops = 0;
+  size_t nof_failed = 0;
+
+  /* Step 1 */
+  enum pobj_stats_enabled stats_enabled = POBJ_STATS_ENABLED_TRANSIENT;
+  ASSERT_EQ(0, pmemobj_ctl_set(pop, "stats.enabled", &stats_enabled))
+      << pmemobj_errormsg();
+  perf_report::Record("distribution", distribution.GetName());
+  perf_report::Record("live_ratio", live_ratio);
+
+  /* Step 2 */
+  Stopwatch total;
+  Stopwatch period;
+  for (size_t snapshot = 0; snapshot < nof_snapshots; ++nof_ops) {
+    unsigned op = operation(generator);
+    bool growing = live_bytes < target_bytes;
+    int ret;
+
+    if (objects.empty() || op < (growing ? 6u : 2u)) {
+      ret = Allocate(records, distribution.Next(), period_stats, write_stats);
+    } else if (op < (growing ? 8u : 4u)) {
+      ret = Reallocate(records, distribution.Next());
+    } else {
+      FreeRandom();
+      ret = 0;
+    }
+
+    ASSERT_NE(-1, ret) << pmemobj_errormsg();
+    if (ret == 1) {
+      nof_failed++;
+      if (!objects.empty()) {
+        FreeRandom();
+      }
+    }
+
+    /* Step 3 */
+    if (period.ElapsedNs() >= period_ns) {
+      total_stats.Merge(period_stats);
+      ReportSnapshot(snapshot++, total.ElapsedSec(),
+                     ProbeFreeSpace(probe_distribution), period_stats);
+      period_stats = LatencyStats();
+      period.Restart();
+    }
+  }
+
+  /* Step 4 */
+  size_t nof_records = 0;
+  ASSERT_EQ(0, records.Verify(nof_records));
+  ASSERT_EQ(objects.size(), nof_records);
+  while (!objects.empty()) {
+    FreeRandom();
+  }
+
+  /* Step 5 */
+  ASSERT_TRUE(OID_IS_NULL(pmemobj_first(pop)));
+
+  /* Step 6 */
+  perf_report::Record("operations", nof_ops);
+  perf_report::Record("failed_allocations", nof_failed);
+  perf_report::RecordLatency("alloc", total_stats);
+  perf_report::RecordLatency("write", write_stats);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    HeapAging, PmemobjHeapAgingPerfParamTest,
+    ::testing::Combine(::testing::Values(SizeDistributionType::UNIFORM,
+                                         SizeDistributionType::LOGNORMAL,
+                                         SizeDistributionType::BIMODAL,
+                                         SizeDistributionType::ZIPF),
+                       ::testing::Values(0.5, 0.75, 0.9)));
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heap_fill.h"
+#include <cerrno>
+#include "perf/stopwatch.h"
+
+void PmemobjHeapFillPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjHeapFillPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjHeapFillPerfTest::Fill(size_t size, size_t nof_objects) {
+  while (objects.size() < nof_objects) {
+    PMEMoid oid = OID_NULL;
+    if (pmemobj_alloc(pop, &oid, size, 0, nullptr, nullptr) != 0) {
+      return errno == ENOMEM ? 1 : -1;
+    }
+    objects.push_back(oid);
+  }
+  return 0;
+}
+
+void PmemobjHeapFillPerfTest::FreeAll() {
+  for (auto &oid : objects) {
+    pmemobj_free(&oid);
+  }
+  objects.clear();
+}
+
+size_t PmemobjHeapFillPerfTest::Measure(size_t size, LatencyStats &alloc_stats,
+                                        LatencyStats &free_stats) {
+  size_t nof_failed = 0;
+
+  alloc_stats.Reserve(nof_samples);
+  free_stats.Reserve(nof_samples);
+  for (size_t i = 0; i < nof_samples; ++i) {
+    PMEMoid oid = OID_NULL;
+
+    Stopwatch stopwatch;
+    int ret = pmemobj_alloc(pop, &oid, size, 0, nullptr, nullptr);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+
+    if (ret != 0) {
+      nof_failed++;
+      continue;
+    }
+    alloc_stats.Add(elapsed);
+    objects.push_back(oid);
+
+    std::uniform_int_distribution<size_t> index(0, objects.size() - 1);
+    PMEMoid &victim = objects[index(generator)];
+
+    stopwatch.Restart();
+    pmemobj_free(&victim);
+    free_stats.Add(stopwatch.ElapsedNs());
+
+    victim = objects.back();
+    objects.pop_back();
+  }
+
+  return nof_failed;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_HEAP_FILL_PERF_H
+#define PMDK_TESTS_HEAP_FILL_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjHeapFillPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "heap_fill_perf";
+  const size_t pool_size = 512 * MEBIBYTE;
+  /* number of allocations and frees measured at each fill level */
+  const size_t nof_samples = 10000;
+  /* fill levels in percent of the number of objects fitting in the pool */
+  const std::vector<unsigned> fill_levels = {50, 80, 90, 95, 99};
+  std::vector<PMEMoid> objects;
+  std::mt19937_64 generator;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * Fill -- allocates objects of given size until there are nof_objects
+   * objects in the pool or allocation fails. Returns 0 on success, 1 if
+   * there is no space left in the pool and -1 on any other error.
+   */
+  int Fill(size_t size, size_t nof_objects);
+
+  /*
+   * FreeAll -- frees all allocated objects.
+   */
+  void FreeAll();
+
+  /*
+   * Measure -- nof_samples times allocates object of given size and frees
+   * randomly chosen object, keeping the fill level constant, and collects
+   * latency of allocations and frees. Returns number of failed allocations.
+   */
+  size_t Measure(size_t size, LatencyStats &alloc_stats,
+                 LatencyStats &free_stats);
+};
+
+class PmemobjHeapFillPerfParamTest
+    : public PmemobjHeapFillPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+#endif  // PMDK_TESTS_HEAP_FILL_PERF_H
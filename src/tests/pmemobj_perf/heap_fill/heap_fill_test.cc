@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cstdint>
+#include "heap_fill.h"
+#include "perf/perf_report.h"
+
+/**
+ * HEAP_FILL_LATENCY
+ * Parameterized Test Case: Measures allocation and free latency percentiles
+ * of objects of given size (s) when the pool is filled to 50, 80, 90, 95 and
+ * 99 percent of its capacity. Sizes cover small (128 B), medium (16 KiB) and
+ * huge (1 MiB) objects
+ * \test
+ *          \li \c Step1. Allocate objects of size s until the pool is
+ *          exhausted to find its capacity (c) and free them / SUCCESS
+ *          \li \c Step2. Allocate objects until the fill level (l) of c is
+ *          reached / SUCCESS
+ *          \li \c Step3. 10000 times allocate object of size s and free
+ *          randomly chosen object measuring latency of both operations
+ *          \li \c Step4. Report allocation and free latency percentiles and
+ *          number of failed allocations for l
+ *          \li \c Step5. Repeat steps 2-4 for all fill levels
+ *          \li \c Step6. Report growth of tail latency between the lowest and
+ *          the highest fill level
+ *          \li \c Step7. Free all objects and verify that the pool is empty
+ */
+TEST_P(PmemobjHeapFillPerfParamTest, HEAP_FILL_LATENCY) {
+  const size_t size = GetParam();
+  LatencyStats first_alloc_stats;
+  LatencyStats last_alloc_stats;
+
+  /* Step 1 */
+  ASSERT_EQ(1, Fill(size, SIZE_MAX)) << pmemobj_errormsg();
+  const size_t capacity = objects.size();
+  ASSERT_LT(0u, capacity);
+  FreeAll();
+  perf_report::Record("size", size, "B");
+  perf_report::Record("capacity", capacity);
+
+  /* Step 5 */
+  for (unsigned level : fill_levels) {
+    /* Step 2 */
+    ASSERT_NE(-1, Fill(size, capacity * level / 100)) << pmemobj_errormsg();
+
+    /* Step 3 */
+    LatencyStats alloc_stats;
+    LatencyStats free_stats;
+    size_t nof_failed = Measure(size, alloc_stats, free_stats);
+
+    /* Step 4 */
+    const std::string prefix = "fill_" + std::to_string(level);
+    perf_report::Record(prefix + "_objects", objects.size());
+    perf_report::Record(prefix + "_failed_allocations", nof_failed);
+    perf_report::RecordLatency(prefix + "_alloc", alloc_stats);
+    perf_report::RecordLatency(prefix + "_free", free_stats);
+
+    if (level == fill_levels.front()) {
+      first_alloc_stats = alloc_stats;
+    }
+    last_alloc_stats = alloc_stats;
+  }
+
+  /* Step 6 */
+  if (first_alloc_stats.GetCount() > 0 && last_alloc_stats.GetCount() > 0) {
+    perf_report::Record(
+        "alloc_p99_growth",
+        static_cast<double>(last_alloc_stats.GetPercentile(99)) /
+            first_alloc_stats.GetPercentile(99));
+  }
+
+  /* Step 7 */
+  FreeAll();
+  ASSERT_TRUE(OID_IS_NULL(pmemobj_first(pop)));
+}
+
+INSTANTIATE_TEST_CASE_P(HeapFill, PmemobjHeapFillPerfParamTest,
+                        ::testing::Values(128, 16 * KIBIBYTE, MEBIBYTE));
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heap_growth.h"
+#include <algorithm>
+#include <functional>
+
+void PmemobjHeapGrowthPerfTest::SetUp() {
+  ASSERT_EQ(0, psm_.CreatePoolsetFile(poolset_));
+}
+
+void PmemobjHeapGrowthPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  if (psm_.AllFilesExist(poolset_)) {
+    psm_.RemovePartsFromPoolset(poolset_);
+  }
+  psm_.RemovePoolsetFile(poolset_);
+}
+
+int PmemobjHeapGrowthPerfTest::CreatePool(uint64_t granularity) {
+  pop = pmemobj_create(poolset_.GetFullPath().c_str(), layout_.c_str(), 0,
+                       S_IWRITE | S_IREAD);
+  if (pop == nullptr) {
+    std::cerr << "Pool creation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  if (pmemobj_ctl_set(pop, "heap.size.granularity", &granularity) != 0) {
+    std::cerr << "Setting heap.size.granularity failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+double PmemobjHeapGrowthPerfTest::GetTopMean(std::vector<uint64_t> latencies,
+                                             size_t nof_top) const {
+  nof_top = std::min(nof_top, latencies.size());
+  if (nof_top == 0) {
+    return 0;
+  }
+
+  std::nth_element(latencies.begin(), latencies.begin() + nof_top - 1,
+                   latencies.end(), std::greater<uint64_t>());
+  double sum = 0;
+  for (size_t i = 0; i < nof_top; ++i) {
+    sum += latencies[i];
+  }
+  return sum / nof_top;
+}
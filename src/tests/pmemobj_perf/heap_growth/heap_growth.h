@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_HEAP_GROWTH_PERF_H
+#define PMDK_TESTS_HEAP_GROWTH_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_management.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjHeapGrowthPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  PoolsetManagement psm_;
+  const size_t max_pool_size = GIGIBYTE;
+  const Poolset poolset_ =
+      Poolset(test_dir_, "heap_growth.set",
+              {{"PMEMPOOLSET", "1G " + test_dir_ + "heap_growth" + SEPARATOR}});
+  const std::string layout_ = "heap_growth_perf";
+  const size_t object_size = 4 * KIBIBYTE;
+  const size_t bytes_to_allocate = 512 * MEBIBYTE;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  /*
+   * CreatePool -- creates pool on pool set with a single directory part and
+   * sets heap.size.granularity to given value. Returns 0 on success, prints
+   * error message and returns -1 otherwise.
+   */
+  int CreatePool(uint64_t granularity);
+
+  /*
+   * GetTopMean -- returns mean of nof_top highest latencies.
+   */
+  double GetTopMean(std::vector<uint64_t> latencies, size_t nof_top) const;
+};
+
+class PmemobjHeapGrowthGranularityPerfParamTest
+    : public PmemobjHeapGrowthPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+class PmemobjHeapExtendPerfParamTest
+    : public PmemobjHeapGrowthPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+#endif  // PMDK_TESTS_HEAP_GROWTH_PERF_H
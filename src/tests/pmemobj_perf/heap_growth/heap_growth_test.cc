@@ -0,0 +1,153 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cerrno>
+#include "heap_growth.h"
+#include "perf/latency_stats.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "perf/stopwatch.h"
+
+/**
+ * HEAP_GROWTH_GRANULARITY
+ * Parameterized Test Case: Measures allocation latency while the heap grows
+ * automatically on pool set with a single directory part, with given
+ * heap.size.granularity (g)
+ * \test
+ *          \li \c Step1. Create pool on pool set with 1 GiB directory part and
+ *          set heap.size.granularity to g / SUCCESS
+ *          \li \c Step2. Allocate 512 MiB in 4 KiB objects measuring latency
+ *          of each allocation / SUCCESS
+ *          \li \c Step3. Verify number of objects in the pool
+ *          \li \c Step4. Report allocation latency and mean latency of the
+ *          512 MiB / g slowest allocations, which approximates cost of
+ *          allocations extending the heap
+ */
+TEST_P(PmemobjHeapGrowthGranularityPerfParamTest, HEAP_GROWTH_GRANULARITY) {
+  const size_t granularity = GetParam();
+  const size_t nof_objects = bytes_to_allocate / object_size;
+  std::vector<uint64_t> latencies;
+  latencies.reserve(nof_objects);
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), max_pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(granularity));
+
+  /* Step 2 */
+  for (size_t i = 0; i < nof_objects; ++i) {
+    Stopwatch stopwatch;
+    ASSERT_EQ(0, pmemobj_alloc(pop, nullptr, object_size, 0, nullptr, nullptr))
+        << pmemobj_errormsg();
+    latencies.push_back(stopwatch.ElapsedNs());
+  }
+
+  /* Step 3 */
+  ASSERT_EQ(nof_objects, perf_utils::CountObjects(pop));
+
+  /* Step 4 */
+  LatencyStats stats;
+  for (auto latency : latencies) {
+    stats.Add(latency);
+  }
+  const size_t nof_extensions =
+      (bytes_to_allocate + granularity - 1) / granularity;
+  perf_report::Record("granularity", granularity, "B");
+  perf_report::RecordLatency("alloc", stats);
+  perf_report::Record("extensions", nof_extensions);
+  perf_report::Record("extension_alloc_mean",
+                      GetTopMean(latencies, nof_extensions), "ns");
+}
+
+INSTANTIATE_TEST_CASE_P(HeapGrowth, PmemobjHeapGrowthGranularityPerfParamTest,
+                        ::testing::Values(4 * MEBIBYTE, 16 * MEBIBYTE,
+                                          64 * MEBIBYTE, 128 * MEBIBYTE));
+
+/**
+ * HEAP_SIZE_EXTEND
+ * Parameterized Test Case: Measures latency of extending the heap manually
+ * with heap.size.extend by given size (e) and latency of allocations from the
+ * extended heap, on pool set with a single directory part and automatic heap
+ * growth disabled
+ * \test
+ *          \li \c Step1. Create pool on pool set with 1 GiB directory part and
+ *          set heap.size.granularity to 0 / SUCCESS
+ *          \li \c Step2. Allocate 512 MiB in 4 KiB objects measuring latency
+ *          of each allocation. Whenever allocation fails with ENOMEM, extend
+ *          the heap by e with heap.size.extend measuring its latency and
+ *          retry the allocation / SUCCESS
+ *          \li \c Step3. Verify number of objects in the pool
+ *          \li \c Step4. Report latency of allocations and heap extensions
+ */
+TEST_P(PmemobjHeapExtendPerfParamTest, HEAP_SIZE_EXTEND) {
+  uint64_t extend_size = GetParam();
+  const size_t nof_objects = bytes_to_allocate / object_size;
+  LatencyStats alloc_stats;
+  LatencyStats extend_stats;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), max_pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(0));
+
+  /* Step 2 */
+  for (size_t i = 0; i < nof_objects; ++i) {
+    Stopwatch stopwatch;
+    while (pmemobj_alloc(pop, nullptr, object_size, 0, nullptr, nullptr) !=
+           0) {
+      ASSERT_EQ(ENOMEM, errno) << pmemobj_errormsg();
+      Stopwatch extend;
+      ASSERT_EQ(0, pmemobj_ctl_exec(pop, "heap.size.extend", &extend_size))
+          << pmemobj_errormsg();
+      extend_stats.Add(extend.ElapsedNs());
+      stopwatch.Restart();
+    }
+    alloc_stats.Add(stopwatch.ElapsedNs());
+  }
+
+  /* Step 3 */
+  ASSERT_EQ(nof_objects, perf_utils::CountObjects(pop));
+
+  /* Step 4 */
+  perf_report::Record("extend_size", extend_size, "B");
+  perf_report::RecordLatency("alloc", alloc_stats);
+  perf_report::RecordLatency("extend", extend_stats);
+}
+
+INSTANTIATE_TEST_CASE_P(HeapGrowth, PmemobjHeapExtendPerfParamTest,
+                        ::testing::Values(4 * MEBIBYTE, 16 * MEBIBYTE,
+                                          64 * MEBIBYTE));
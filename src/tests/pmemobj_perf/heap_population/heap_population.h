@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_HEAP_POPULATION_PERF_H
+#define PMDK_TESTS_HEAP_POPULATION_PERF_H
+
+#include <libpmemobj.h>
+#include <array>
+#include <memory>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjHeapPopulationPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "heap_population_perf";
+  /* Object sizes allocated in turns. Together with compact header they fill
+   * 32, 64, 128 and 256 B allocation units. */
+  const std::array<size_t, 4> object_sizes = {{16, 48, 112, 240}};
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  size_t GetPoolSize(size_t nof_objects) const {
+    return 64 * MEBIBYTE + nof_objects * 256;
+  }
+
+  /*
+   * FillPool -- allocates nof_objects objects of sizes taken in turns from
+   * object_sizes. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  int FillPool(size_t nof_objects);
+};
+
+class PmemobjHeapPopulationPerfParamTest
+    : public PmemobjHeapPopulationPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+#endif  // PMDK_TESTS_HEAP_POPULATION_PERF_H
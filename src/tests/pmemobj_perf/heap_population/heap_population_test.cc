@@ -0,0 +1,125 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heap_population.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "perf/stopwatch.h"
+
+/**
+ * HEAP_POPULATION_SCALING
+ * Parameterized Test Case: Measures how iteration over all objects, pool open
+ * and the first allocation after open scale with the number of live objects
+ * (n) of mixed sizes
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file / SUCCESS
+ *          \li \c Step2. Allocate n objects of mixed sizes / SUCCESS
+ *          \li \c Step3. Iterate over all objects with pmemobj_first and
+ *          pmemobj_next and verify that n objects were found
+ *          \li \c Step4. Close and reopen the pool measuring the open time
+ *          / SUCCESS
+ *          \li \c Step5. Allocate an object measuring the latency of the first
+ *          allocation after open / SUCCESS
+ *          \li \c Step6. Allocate another object measuring its latency
+ *          / SUCCESS
+ *          \li \c Step7. Iterate over all objects again and verify that n + 2
+ *          objects were found
+ *          \li \c Step8. Report measured times
+ */
+TEST_P(PmemobjHeapPopulationPerfParamTest, HEAP_POPULATION_SCALING) {
+  const size_t nof_objects = GetParam();
+  PMEMoid oid;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), GetPoolSize(nof_objects))) {
+    return;
+  }
+
+  /* Step 1 */
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(),
+                       GetPoolSize(nof_objects), S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+
+  /* Step 2 */
+  Stopwatch fill_time;
+  ASSERT_EQ(0, FillPool(nof_objects));
+  uint64_t fill_ns = fill_time.ElapsedNs();
+
+  /* Step 3 */
+  Stopwatch iteration_time;
+  size_t count = perf_utils::CountObjects(pop);
+  uint64_t iteration_ns = iteration_time.ElapsedNs();
+  ASSERT_EQ(nof_objects, count);
+
+  /* Step 4 */
+  pmemobj_close(pop);
+  Stopwatch open_time;
+  pop = pmemobj_open(pool_path_.c_str(), layout_.c_str());
+  uint64_t open_ns = open_time.ElapsedNs();
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+
+  /* Step 5 */
+  Stopwatch first_alloc_time;
+  ASSERT_EQ(0, pmemobj_alloc(pop, &oid, object_sizes[0], 0, nullptr, nullptr))
+      << pmemobj_errormsg();
+  uint64_t first_alloc_ns = first_alloc_time.ElapsedNs();
+
+  /* Step 6 */
+  Stopwatch next_alloc_time;
+  ASSERT_EQ(0, pmemobj_alloc(pop, &oid, object_sizes[0], 0, nullptr, nullptr))
+      << pmemobj_errormsg();
+  uint64_t next_alloc_ns = next_alloc_time.ElapsedNs();
+
+  /* Step 7 */
+  Stopwatch reopened_iteration_time;
+  count = perf_utils::CountObjects(pop);
+  uint64_t reopened_iteration_ns = reopened_iteration_time.ElapsedNs();
+  ASSERT_EQ(nof_objects + 2, count);
+
+  /* Step 8 */
+  perf_report::Record("nof_objects", nof_objects);
+  perf_report::Record("fill_throughput",
+                      perf_report::OpsPerSec(nof_objects, fill_ns), "ops/s");
+  perf_report::Record("iteration_time", iteration_ns, "ns");
+  perf_report::Record("iteration_time_per_object",
+                      static_cast<double>(iteration_ns) / nof_objects, "ns");
+  perf_report::Record("open_time", open_ns, "ns");
+  perf_report::Record("first_alloc_after_open", first_alloc_ns, "ns");
+  perf_report::Record("next_alloc_after_open", next_alloc_ns, "ns");
+  perf_report::Record("iteration_time_after_open", reopened_iteration_ns,
+                      "ns");
+}
+
+INSTANTIATE_TEST_CASE_P(HeapPopulationPerfParam,
+                        PmemobjHeapPopulationPerfParamTest,
+                        ::testing::Values(1000, 10000, 100000, 1000000,
+                                          10000000, 100000000));
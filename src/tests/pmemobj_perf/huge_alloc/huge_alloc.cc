@@ -0,0 +1,120 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "huge_alloc.h"
+#include <algorithm>
+#include "perf/stopwatch.h"
+
+void PmemobjHugeAllocPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+size_t PmemobjHugeAllocPerfTest::GetNofObjects(size_t size) const {
+  size_t nof_objects =
+      std::min(max_objects, std::max(min_objects, bytes_per_pass / size));
+  return std::min(nof_objects, chunks_per_zone / GetNofChunks(size));
+}
+
+size_t PmemobjHugeAllocPerfTest::GetPoolSize(size_t size) const {
+  return GetNofObjects(size) * GetNofChunks(size) * chunk_size +
+         pool_overhead;
+}
+
+size_t PmemobjHugeAllocPerfTest::GetNofChunks(size_t size) const {
+  /* objects are preceded by allocation header of at most 64 bytes */
+  return (size + 64 + chunk_size - 1) / chunk_size;
+}
+
+int PmemobjHugeAllocPerfTest::AllocateAll(size_t size, size_t nof_objects,
+                                          LatencyStats &stats) {
+  stats.Reserve(nof_objects);
+  while (objects.size() < nof_objects) {
+    PMEMoid oid = OID_NULL;
+
+    Stopwatch stopwatch;
+    int ret = pmemobj_alloc(pop, &oid, size, 0, nullptr, nullptr);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+
+    if (ret != 0) {
+      std::cerr << "Allocation of object " << objects.size()
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+    stats.Add(elapsed);
+    objects.push_back(oid);
+  }
+  return 0;
+}
+
+void PmemobjHugeAllocPerfTest::FreeEvery(size_t first, LatencyStats &stats) {
+  for (size_t i = first; i < objects.size(); i += 2) {
+    Stopwatch stopwatch;
+    pmemobj_free(&objects[i]);
+    stats.Add(stopwatch.ElapsedNs());
+  }
+}
+
+int PmemobjHugeAllocPerfTest::ReservePublish(size_t size, size_t nof_objects,
+                                             LatencyStats &reserve_stats,
+                                             LatencyStats &publish_stats) {
+  for (size_t i = 0; i < nof_objects; ++i) {
+    pobj_action act;
+
+    Stopwatch stopwatch;
+    PMEMoid oid = pmemobj_reserve(pop, &act, size, 0);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+
+    if (OID_IS_NULL(oid)) {
+      std::cerr << "Reservation of object " << i
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+    reserve_stats.Add(elapsed);
+
+    stopwatch.Restart();
+    int ret = pmemobj_publish(pop, &act, 1);
+    elapsed = stopwatch.ElapsedNs();
+
+    if (ret != 0) {
+      std::cerr << "Publication of object " << i
+                << " failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+    publish_stats.Add(elapsed);
+    objects.push_back(oid);
+  }
+  return 0;
+}
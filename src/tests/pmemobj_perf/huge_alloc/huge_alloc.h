@@ -0,0 +1,113 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_HUGE_ALLOC_PERF_H
+#define PMDK_TESTS_HUGE_ALLOC_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjHugeAllocPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "huge_alloc_perf";
+  /* size of the heap chunk in libpmemobj */
+  const size_t chunk_size = 256 * KIBIBYTE;
+  /* number of chunks in a heap zone, huge objects cannot span zones */
+  const size_t chunks_per_zone = 65528;
+  /* space reserved in the pool for metadata and alignment of objects */
+  const size_t pool_overhead = 64 * MEBIBYTE;
+  /* number of bytes allocated in each pass, bounded by object counts */
+  const size_t bytes_per_pass = GIGIBYTE;
+  /* at least 3 objects are needed to free one with free neighbours */
+  const size_t min_objects = 3;
+  const size_t max_objects = 256;
+  std::vector<PMEMoid> objects;
+
+ public:
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  /*
+   * GetNofObjects -- returns number of objects allocated in a pass, bounded
+   * so that all of them fit in the first heap zone.
+   */
+  size_t GetNofObjects(size_t size) const;
+  size_t GetPoolSize(size_t size) const;
+
+  /*
+   * GetNofChunks -- returns number of heap chunks spanned by object of given
+   * size, including the allocation header.
+   */
+  size_t GetNofChunks(size_t size) const;
+
+  /*
+   * AllocateAll -- allocates objects of given size until there are
+   * nof_objects of them, collecting latency of each allocation. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  int AllocateAll(size_t size, size_t nof_objects, LatencyStats &stats);
+
+  /*
+   * FreeEvery -- frees objects with indexes first, first + 2, first + 4...
+   * collecting latency of each free.
+   */
+  void FreeEvery(size_t first, LatencyStats &stats);
+
+  /*
+   * ReservePublish -- reserves nof_objects objects of given size one by one
+   * and publishes each reservation, collecting latency of reservations and
+   * publications separately. Returns 0 on success, prints error message and
+   * returns -1 otherwise.
+   */
+  int ReservePublish(size_t size, size_t nof_objects,
+                     LatencyStats &reserve_stats, LatencyStats &publish_stats);
+};
+
+class PmemobjHugeAllocPerfParamTest
+    : public PmemobjHugeAllocPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+#endif  // PMDK_TESTS_HUGE_ALLOC_PERF_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "huge_alloc.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "perf/stopwatch.h"
+
+/**
+ * HUGE_ALLOC
+ * Parameterized Test Case: Measures latency of allocation, free and
+ * reserve/publish of huge objects of given size (s) spanning many heap
+ * chunks, and cost of coalescing free chunks. 1 GiB is allocated in each
+ * pass, but at least 3 and at most 256 objects, and no more than fit in a
+ * single heap zone
+ * \test
+ *          \li \c Step1. Create pool fitting all objects (skip if there is
+ *          not enough free space) / SUCCESS
+ *          \li \c Step2. Allocate objects of size s measuring latency of each
+ *          allocation / SUCCESS
+ *          \li \c Step3. Free objects with even indexes measuring latency, so
+ *          that freed chunks have no free neighbours / SUCCESS
+ *          \li \c Step4. Free objects with odd indexes measuring latency, so
+ *          that freed chunks are coalesced with free neighbours on both
+ *          sides / SUCCESS
+ *          \li \c Step5. Allocate single object spanning half of coalesced
+ *          space measuring latency and free it / SUCCESS
+ *          \li \c Step6. Reserve and publish objects of size s one by one
+ *          measuring latency of both operations and free them / SUCCESS
+ *          \li \c Step7. Verify that the pool is empty
+ *          \li \c Step8. Report latencies, number of chunks per object,
+ *          allocation latency per chunk and coalescing cost
+ */
+TEST_P(PmemobjHugeAllocPerfParamTest, HUGE_ALLOC) {
+  const size_t size = GetParam();
+  const size_t nof_objects = GetNofObjects(size);
+  const size_t pool_size = GetPoolSize(size);
+  LatencyStats alloc_stats;
+  LatencyStats isolated_free_stats;
+  LatencyStats coalescing_free_stats;
+  LatencyStats reserve_stats;
+  LatencyStats publish_stats;
+
+  /* Step 1 */
+  if (!perf_utils::HasFreeSpace(GetTestDir(), pool_size)) {
+    return;
+  }
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+
+  /* Step 2 */
+  ASSERT_EQ(0, AllocateAll(size, nof_objects, alloc_stats));
+
+  /* Step 3 */
+  FreeEvery(0, isolated_free_stats);
+
+  /* Step 4 */
+  FreeEvery(1, coalescing_free_stats);
+  objects.clear();
+
+  /* Step 5 */
+  PMEMoid oid = OID_NULL;
+  const size_t coalesced_size = nof_objects / 2 * size;
+  ASSERT_GE(chunks_per_zone, GetNofChunks(coalesced_size));
+  Stopwatch stopwatch;
+  ASSERT_EQ(0, pmemobj_alloc(pop, &oid, coalesced_size, 0, nullptr, nullptr))
+      << pmemobj_errormsg();
+  uint64_t coalesced_alloc = stopwatch.ElapsedNs();
+  pmemobj_free(&oid);
+
+  /* Step 6 */
+  ASSERT_EQ(0,
+            ReservePublish(size, nof_objects, reserve_stats, publish_stats));
+  for (auto &object : objects) {
+    pmemobj_free(&object);
+  }
+  objects.clear();
+
+  /* Step 7 */
+  ASSERT_TRUE(OID_IS_NULL(pmemobj_first(pop)));
+
+  /* Step 8 */
+  const size_t nof_chunks = GetNofChunks(size);
+  perf_report::Record("size", size, "B");
+  perf_report::Record("objects", nof_objects);
+  perf_report::Record("chunks_per_object", nof_chunks);
+  perf_report::RecordLatency("alloc", alloc_stats);
+  perf_report::Record("alloc_per_chunk", alloc_stats.GetMean() / nof_chunks,
+                      "ns");
+  perf_report::RecordLatency("isolated_free", isolated_free_stats);
+  perf_report::RecordLatency("coalescing_free", coalescing_free_stats);
+  perf_report::Record(
+      "coalescing_cost",
+      coalescing_free_stats.GetMean() - isolated_free_stats.GetMean(), "ns");
+  perf_report::Record("coalesced_alloc", coalesced_alloc, "ns");
+  perf_report::RecordLatency("reserve", reserve_stats);
+  perf_report::RecordLatency("publish", publish_stats);
+}
+
+INSTANTIATE_TEST_CASE_P(HugeAlloc, PmemobjHugeAllocPerfParamTest,
+                        ::testing::Values(256 * KIBIBYTE, MEBIBYTE,
+                                          16 * MEBIBYTE, 256 * MEBIBYTE,
+                                          GIGIBYTE, 4 * GIGIBYTE));
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "locks.h"
+#include "perf/perf_report.h"
+
+void PmemobjLocksPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(locks_root));
+  ASSERT_FALSE(OID_IS_NULL(root_oid)) << pmemobj_errormsg();
+  root = static_cast<locks_root *>(pmemobj_direct(root_oid));
+}
+
+void PmemobjLocksPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+uint64_t PmemobjLocksPerfTest::CriticalSection(size_t cs_length,
+                                               bool exclusive) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < cs_length; i++) {
+    sum += shared_data_[i % shared_data_.size()];
+  }
+  if (exclusive) {
+    ++shared_data_[0];
+  }
+  return sum;
+}
+
+void PmemobjLocksPerfTest::ReportResults(size_t nof_threads, size_t cs_length,
+                                         size_t nof_ops, uint64_t elapsed_ns,
+                                         LatencyStats &stats) {
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("cs_length", cs_length);
+  perf_report::Record("throughput",
+                      perf_report::OpsPerSec(nof_threads * nof_ops, elapsed_ns),
+                      "ops/s");
+  perf_report::RecordLatency("acquire", stats);
+}
+
+void PmemobjLocksPerfParamTest::SetUp() {
+  PmemobjLocksPerfTest::SetUp();
+  nof_threads = std::get<0>(GetParam());
+  cs_length = std::get<1>(GetParam());
+}
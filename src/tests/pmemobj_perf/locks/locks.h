@@ -0,0 +1,194 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_LOCKS_PERF_H
+#define PMDK_TESTS_LOCKS_PERF_H
+
+#include <libpmemobj.h>
+#include <array>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+#include "perf/stopwatch.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+struct locks_root {
+  PMEMmutex mutex;
+  PMEMrwlock rwlock;
+  PMEMcond cond;
+};
+
+class PmemobjLocksPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+  std::array<uint64_t, 64> shared_data_{};
+  std::atomic<uint64_t> sink_{0};
+  bool turn_ = false;
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  locks_root *root = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "locks_perf";
+  const size_t pool_size = 64 * MEBIBYTE;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * CriticalSection -- simulates work done while holding a lock by reading
+   * shared data cs_length times. Exclusive critical section additionally
+   * increments a shared counter, so exclusive access can be verified with
+   * GetExclusiveCount().
+   */
+  uint64_t CriticalSection(size_t cs_length, bool exclusive);
+  uint64_t GetExclusiveCount() const {
+    return shared_data_[0];
+  }
+
+  /*
+   * RunLockWorkload -- runs lock, critical section and unlock sequence
+   * nof_ops times in each of nof_threads threads released at the same time.
+   * Collects lock acquisition latencies in stats and returns total execution
+   * time in nanoseconds.
+   */
+  template <typename Lock, typename Unlock>
+  uint64_t RunLockWorkload(size_t nof_threads, size_t cs_length,
+                           size_t nof_ops, bool exclusive, Lock lock,
+                           Unlock unlock, LatencyStats &stats);
+
+  /*
+   * RunPingPong -- passes the turn between two threads nof_rounds times using
+   * given mutex and condition variable operations. Returns total execution
+   * time in nanoseconds.
+   */
+  template <typename Lock, typename Unlock, typename Wait, typename Signal>
+  uint64_t RunPingPong(size_t nof_rounds, Lock lock, Unlock unlock, Wait wait,
+                       Signal signal);
+
+  void ReportResults(size_t nof_threads, size_t cs_length, size_t nof_ops,
+                     uint64_t elapsed_ns, LatencyStats &stats);
+};
+
+class PmemobjLocksPerfParamTest
+    : public PmemobjLocksPerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {
+ protected:
+  size_t nof_threads;
+  size_t cs_length;
+  const size_t ops_per_thread = 100000;
+
+ public:
+  void SetUp() override;
+};
+
+class PmemobjLocksReinitPerfParamTest
+    : public PmemobjLocksPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+template <typename Lock, typename Unlock>
+uint64_t PmemobjLocksPerfTest::RunLockWorkload(size_t nof_threads,
+                                               size_t cs_length, size_t nof_ops,
+                                               bool exclusive, Lock lock,
+                                               Unlock unlock,
+                                               LatencyStats &stats) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<LatencyStats>> future_stats;
+
+  for (size_t th = 0; th < nof_threads; th++) {
+    future_stats.push_back(std::async(std::launch::async, [&, started]() {
+      LatencyStats thread_stats;
+      thread_stats.Reserve(nof_ops);
+      uint64_t sum = 0;
+      started.wait();
+      for (size_t i = 0; i < nof_ops; i++) {
+        Stopwatch acquire;
+        lock();
+        thread_stats.Add(acquire.ElapsedNs());
+        sum += CriticalSection(cs_length, exclusive);
+        unlock();
+      }
+      sink_ += sum;
+      return thread_stats;
+    }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &future_stat : future_stats) {
+    stats.Merge(future_stat.get());
+  }
+  return total.ElapsedNs();
+}
+
+template <typename Lock, typename Unlock, typename Wait, typename Signal>
+uint64_t PmemobjLocksPerfTest::RunPingPong(size_t nof_rounds, Lock lock,
+                                           Unlock unlock, Wait wait,
+                                           Signal signal) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<void>> players;
+
+  turn_ = false;
+  for (bool player : {false, true}) {
+    players.push_back(std::async(std::launch::async, [&, player, started]() {
+      started.wait();
+      for (size_t i = 0; i < nof_rounds; i++) {
+        lock();
+        while (turn_ != player) {
+          wait();
+        }
+        turn_ = !player;
+        signal();
+        unlock();
+      }
+    }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &player : players) {
+    player.get();
+  }
+  return total.ElapsedNs();
+}
+
+#endif  // PMDK_TESTS_LOCKS_PERF_H
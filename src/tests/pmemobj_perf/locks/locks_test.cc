@@ -0,0 +1,343 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include "locks.h"
+#include "perf/perf_report.h"
+
+/**
+ * PMEMOBJ_MUTEX_CONTENTION
+ * Parameterized Test Case: Measures throughput and acquisition latency of
+ * PMEMmutex under contention. Parameters are:
+ *  - the number of threads (n)
+ *  - the length of the critical section
+ * \test
+ *          \li \c Step1. Lock and unlock PMEMmutex residing in the root object
+ *          using n threads / SUCCESS
+ *          \li \c Step2. Verify that all critical sections were executed
+ *          exclusively
+ *          \li \c Step3. Report throughput and acquisition latency
+ */
+TEST_P(PmemobjLocksPerfParamTest, PMEMOBJ_MUTEX_CONTENTION) {
+  LatencyStats stats;
+
+  /* Step 1 */
+  uint64_t elapsed = RunLockWorkload(
+      nof_threads, cs_length, ops_per_thread, true,
+      [this]() { EXPECT_EQ(0, pmemobj_mutex_lock(pop, &root->mutex)); },
+      [this]() { EXPECT_EQ(0, pmemobj_mutex_unlock(pop, &root->mutex)); },
+      stats);
+
+  /* Step 2 */
+  EXPECT_EQ(nof_threads * ops_per_thread, GetExclusiveCount());
+
+  /* Step 3 */
+  ReportResults(nof_threads, cs_length, ops_per_thread, elapsed, stats);
+}
+
+/**
+ * STD_MUTEX_CONTENTION
+ * Parameterized Test Case: Measures throughput and acquisition latency of
+ * std::mutex residing in DRAM under contention as a reference for
+ * PMEMOBJ_MUTEX_CONTENTION. Parameters are:
+ *  - the number of threads (n)
+ *  - the length of the critical section
+ * \test
+ *          \li \c Step1. Lock and unlock std::mutex using n threads / SUCCESS
+ *          \li \c Step2. Verify that all critical sections were executed
+ *          exclusively
+ *          \li \c Step3. Report throughput and acquisition latency
+ */
+TEST_P(PmemobjLocksPerfParamTest, STD_MUTEX_CONTENTION) {
+  LatencyStats stats;
+  std::mutex mutex;
+
+  /* Step 1 */
+  uint64_t elapsed =
+      RunLockWorkload(nof_threads, cs_length, ops_per_thread, true,
+                      [&mutex]() { mutex.lock(); },
+                      [&mutex]() { mutex.unlock(); }, stats);
+
+  /* Step 2 */
+  EXPECT_EQ(nof_threads * ops_per_thread, GetExclusiveCount());
+
+  /* Step 3 */
+  ReportResults(nof_threads, cs_length, ops_per_thread, elapsed, stats);
+}
+
+/**
+ * PMEMOBJ_RWLOCK_RDLOCK_CONTENTION
+ * Parameterized Test Case: Measures throughput and acquisition latency of
+ * PMEMrwlock taken for reading. Parameters are:
+ *  - the number of threads (n)
+ *  - the length of the critical section
+ * \test
+ *          \li \c Step1. Read-lock and unlock PMEMrwlock residing in the root
+ *          object using n threads / SUCCESS
+ *          \li \c Step2. Report throughput and acquisition latency
+ */
+TEST_P(PmemobjLocksPerfParamTest, PMEMOBJ_RWLOCK_RDLOCK_CONTENTION) {
+  LatencyStats stats;
+
+  /* Step 1 */
+  uint64_t elapsed = RunLockWorkload(
+      nof_threads, cs_length, ops_per_thread, false,
+      [this]() { EXPECT_EQ(0, pmemobj_rwlock_rdlock(pop, &root->rwlock)); },
+      [this]() { EXPECT_EQ(0, pmemobj_rwlock_unlock(pop, &root->rwlock)); },
+      stats);
+
+  /* Step 2 */
+  ReportResults(nof_threads, cs_length, ops_per_thread, elapsed, stats);
+}
+
+/**
+ * PMEMOBJ_RWLOCK_WRLOCK_CONTENTION
+ * Parameterized Test Case: Measures throughput and acquisition latency of
+ * PMEMrwlock taken for writing. Parameters are:
+ *  - the number of threads (n)
+ *  - the length of the critical section
+ * \test
+ *          \li \c Step1. Write-lock and unlock PMEMrwlock residing in the root
+ *          object using n threads / SUCCESS
+ *          \li \c Step2. Verify that all critical sections were executed
+ *          exclusively
+ *          \li \c Step3. Report throughput and acquisition latency
+ */
+TEST_P(PmemobjLocksPerfParamTest, PMEMOBJ_RWLOCK_WRLOCK_CONTENTION) {
+  LatencyStats stats;
+
+  /* Step 1 */
+  uint64_t elapsed = RunLockWorkload(
+      nof_threads, cs_length, ops_per_thread, true,
+      [this]() { EXPECT_EQ(0, pmemobj_rwlock_wrlock(pop, &root->rwlock)); },
+      [this]() { EXPECT_EQ(0, pmemobj_rwlock_unlock(pop, &root->rwlock)); },
+      stats);
+
+  /* Step 2 */
+  EXPECT_EQ(nof_threads * ops_per_thread, GetExclusiveCount());
+
+  /* Step 3 */
+  ReportResults(nof_threads, cs_length, ops_per_thread, elapsed, stats);
+}
+
+/**
+ * STD_SHARED_MUTEX_SHARED_CONTENTION
+ * Parameterized Test Case: Measures throughput and acquisition latency of
+ * std::shared_timed_mutex residing in DRAM taken in shared mode as a reference
+ * for PMEMOBJ_RWLOCK_RDLOCK_CONTENTION. Parameters are:
+ *  - the number of threads (n)
+ *  - the length of the critical section
+ * \test
+ *          \li \c Step1. Lock and unlock std::shared_timed_mutex in shared mode
+ *          using n threads / SUCCESS
+ *          \li \c Step2. Report throughput and acquisition latency
+ */
+TEST_P(PmemobjLocksPerfParamTest, STD_SHARED_MUTEX_SHARED_CONTENTION) {
+  LatencyStats stats;
+  std::shared_timed_mutex mutex;
+
+  /* Step 1 */
+  uint64_t elapsed =
+      RunLockWorkload(nof_threads, cs_length, ops_per_thread, false,
+                      [&mutex]() { mutex.lock_shared(); },
+                      [&mutex]() { mutex.unlock_shared(); }, stats);
+
+  /* Step 2 */
+  ReportResults(nof_threads, cs_length, ops_per_thread, elapsed, stats);
+}
+
+/**
+ * STD_SHARED_MUTEX_EXCLUSIVE_CONTENTION
+ * Parameterized Test Case: Measures throughput and acquisition latency of
+ * std::shared_timed_mutex residing in DRAM taken in exclusive mode as a
+ * reference for PMEMOBJ_RWLOCK_WRLOCK_CONTENTION. Parameters are:
+ *  - the number of threads (n)
+ *  - the length of the critical section
+ * \test
+ *          \li \c Step1. Lock and unlock std::shared_timed_mutex in exclusive
+ *          mode using n threads / SUCCESS
+ *          \li \c Step2. Verify that all critical sections were executed
+ *          exclusively
+ *          \li \c Step3. Report throughput and acquisition latency
+ */
+TEST_P(PmemobjLocksPerfParamTest, STD_SHARED_MUTEX_EXCLUSIVE_CONTENTION) {
+  LatencyStats stats;
+  std::shared_timed_mutex mutex;
+
+  /* Step 1 */
+  uint64_t elapsed =
+      RunLockWorkload(nof_threads, cs_length, ops_per_thread, true,
+                      [&mutex]() { mutex.lock(); },
+                      [&mutex]() { mutex.unlock(); }, stats);
+
+  /* Step 2 */
+  EXPECT_EQ(nof_threads * ops_per_thread, GetExclusiveCount());
+
+  /* Step 3 */
+  ReportResults(nof_threads, cs_length, ops_per_thread, elapsed, stats);
+}
+
+/**
+ * PMEMOBJ_COND_PING_PONG
+ * Measures round-trip latency of passing the turn between two threads with
+ * PMEMcond and PMEMmutex
+ * \test
+ *          \li \c Step1. Pass the turn between two threads using PMEMcond and
+ *          PMEMmutex residing in the root object / SUCCESS
+ *          \li \c Step2. Report round-trip latency
+ */
+TEST_F(PmemobjLocksPerfTest, PMEMOBJ_COND_PING_PONG) {
+  const size_t nof_rounds = 100000;
+
+  /* Step 1 */
+  uint64_t elapsed = RunPingPong(
+      nof_rounds,
+      [this]() { EXPECT_EQ(0, pmemobj_mutex_lock(pop, &root->mutex)); },
+      [this]() { EXPECT_EQ(0, pmemobj_mutex_unlock(pop, &root->mutex)); },
+      [this]() {
+        EXPECT_EQ(0, pmemobj_cond_wait(pop, &root->cond, &root->mutex));
+      },
+      [this]() { EXPECT_EQ(0, pmemobj_cond_signal(pop, &root->cond)); });
+
+  /* Step 2 */
+  perf_report::Record("round_trip_mean",
+                      static_cast<double>(elapsed) / nof_rounds, "ns");
+}
+
+/**
+ * STD_COND_PING_PONG
+ * Measures round-trip latency of passing the turn between two threads with
+ * std::condition_variable and std::mutex residing in DRAM as a reference for
+ * PMEMOBJ_COND_PING_PONG
+ * \test
+ *          \li \c Step1. Pass the turn between two threads using
+ *          std::condition_variable and std::mutex / SUCCESS
+ *          \li \c Step2. Report round-trip latency
+ */
+TEST_F(PmemobjLocksPerfTest, STD_COND_PING_PONG) {
+  const size_t nof_rounds = 100000;
+  std::mutex mutex;
+  std::condition_variable cond;
+
+  /* Step 1 */
+  uint64_t elapsed = RunPingPong(
+      nof_rounds, [&mutex]() { mutex.lock(); }, [&mutex]() { mutex.unlock(); },
+      [&cond, &mutex]() {
+        std::unique_lock<std::mutex> lock(mutex, std::adopt_lock);
+        cond.wait(lock);
+        lock.release();
+      },
+      [&cond]() { cond.notify_one(); });
+
+  /* Step 2 */
+  perf_report::Record("round_trip_mean",
+                      static_cast<double>(elapsed) / nof_rounds, "ns");
+}
+
+/**
+ * PMEMOBJ_FIRST_LOCK_AFTER_OPEN
+ * Parameterized Test Case: Measures cost of locking PMEMmutex for the first
+ * time after the pool is reopened, which includes lock reinitialization, in a
+ * pool holding given number of locks (n)
+ * \test
+ *          \li \c Step1. Allocate root object holding n PMEMmutex locks
+ *          / SUCCESS
+ *          \li \c Step2. Lock and unlock each of the locks / SUCCESS
+ *          \li \c Step3. Close, check and reopen the pool measuring the open
+ *          time / SUCCESS
+ *          \li \c Step4. Lock and unlock each of the locks measuring the
+ *          latency of the first lock after open / SUCCESS
+ *          \li \c Step5. Lock and unlock each of the locks again measuring the
+ *          latency of subsequent lock / SUCCESS
+ *          \li \c Step6. Report open time and both latencies
+ */
+TEST_P(PmemobjLocksReinitPerfParamTest, PMEMOBJ_FIRST_LOCK_AFTER_OPEN) {
+  const size_t nof_locks = GetParam();
+  LatencyStats first_lock_stats;
+  LatencyStats next_lock_stats;
+
+  /* Step 1 */
+  PMEMoid root_oid = pmemobj_root(pop, nof_locks * sizeof(PMEMmutex));
+  ASSERT_FALSE(OID_IS_NULL(root_oid)) << pmemobj_errormsg();
+  PMEMmutex *locks = static_cast<PMEMmutex *>(pmemobj_direct(root_oid));
+
+  /* Step 2 */
+  for (size_t i = 0; i < nof_locks; i++) {
+    ASSERT_EQ(0, pmemobj_mutex_lock(pop, &locks[i]));
+    ASSERT_EQ(0, pmemobj_mutex_unlock(pop, &locks[i]));
+  }
+
+  /* Step 3 */
+  pmemobj_close(pop);
+  pop = nullptr;
+  ASSERT_EQ(1, pmemobj_check(pool_path_.c_str(), layout_.c_str()));
+  Stopwatch open_time;
+  pop = pmemobj_open(pool_path_.c_str(), layout_.c_str());
+  uint64_t open_ns = open_time.ElapsedNs();
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  root_oid = pmemobj_root(pop, nof_locks * sizeof(PMEMmutex));
+  locks = static_cast<PMEMmutex *>(pmemobj_direct(root_oid));
+
+  /* Step 4 */
+  for (size_t i = 0; i < nof_locks; i++) {
+    Stopwatch lock_time;
+    ASSERT_EQ(0, pmemobj_mutex_lock(pop, &locks[i]));
+    ASSERT_EQ(0, pmemobj_mutex_unlock(pop, &locks[i]));
+    first_lock_stats.Add(lock_time.ElapsedNs());
+  }
+
+  /* Step 5 */
+  for (size_t i = 0; i < nof_locks; i++) {
+    Stopwatch lock_time;
+    ASSERT_EQ(0, pmemobj_mutex_lock(pop, &locks[i]));
+    ASSERT_EQ(0, pmemobj_mutex_unlock(pop, &locks[i]));
+    next_lock_stats.Add(lock_time.ElapsedNs());
+  }
+
+  /* Step 6 */
+  perf_report::Record("nof_locks", nof_locks);
+  perf_report::Record("open_time", open_ns, "ns");
+  perf_report::Record("first_locks_total", first_lock_stats.GetSum(), "ns");
+  perf_report::RecordLatency("first_lock", first_lock_stats);
+  perf_report::RecordLatency("next_lock", next_lock_stats);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    LocksPerfParam, PmemobjLocksPerfParamTest,
+    ::testing::Combine(::testing::Values(1, 2, 4, 8, 16),
+                       ::testing::Values(0, 100, 1000)));
+
+INSTANTIATE_TEST_CASE_P(LocksReinitPerfParam, PmemobjLocksReinitPerfParamTest,
+                        ::testing::Values(1000, 10000, 100000));
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "lru_cache.h"
+#include <algorithm>
+#include <cmath>
+#include "perf/stopwatch.h"
+
+void PmemobjLruCachePerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(cache_root));
+  ASSERT_FALSE(OID_IS_NULL(root_oid)) << pmemobj_errormsg();
+  root = static_cast<cache_root *>(pmemobj_direct(root_oid));
+}
+
+void PmemobjLruCachePerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjLruCachePerfTest::OpenPool() {
+  pmemobj_close(pop);
+  pop = pmemobj_open(pool_path_.c_str(), layout_.c_str());
+  if (pop == nullptr) {
+    std::cerr << "Pool open failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(cache_root));
+  if (OID_IS_NULL(root_oid)) {
+    std::cerr << "Root object retrieval failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+  root = static_cast<cache_root *>(pmemobj_direct(root_oid));
+
+  return 0;
+}
+
+void PmemobjLruCachePerfTest::InitKeys(double skew) {
+  double sum = 0;
+
+  key_cdf.resize(nof_keys);
+  for (size_t rank = 1; rank <= nof_keys; ++rank) {
+    sum += 1 / std::pow(static_cast<double>(rank), skew);
+    key_cdf[rank - 1] = sum;
+  }
+  for (auto &p : key_cdf) {
+    p /= sum;
+  }
+}
+
+uint64_t PmemobjLruCachePerfTest::NextKey() {
+  std::uniform_real_distribution<double> probability(0, 1);
+  auto it = std::lower_bound(key_cdf.begin(), key_cdf.end(),
+                             probability(generator));
+  return std::min<uint64_t>(it - key_cdf.begin(), nof_keys - 1);
+}
+
+void PmemobjLruCachePerfTest::MakeValue(uint64_t key,
+                                        std::vector<char> &value) const {
+  size_t size = min_value_size +
+                (key * 2654435761u) % (max_value_size - min_value_size + 1);
+  value.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    value[i] = static_cast<char>(key + i);
+  }
+}
+
+bool PmemobjLruCachePerfTest::IsValueValid(
+    uint64_t key, const std::vector<char> &value) const {
+  std::vector<char> expected;
+  MakeValue(key, expected);
+  return value == expected;
+}
+
+int PmemobjLruCachePerfTest::RunWorkload(PersistentLruCache &cache,
+                                         CacheStats &stats) {
+  std::vector<char> value;
+
+  for (size_t i = 0; i < nof_ops; ++i) {
+    uint64_t key = NextKey();
+
+    Stopwatch stopwatch;
+    int ret = cache.Get(key, value);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+
+    if (ret == -1) {
+      std::cerr << "Get of key " << key << " failed: " << pmemobj_errormsg()
+                << std::endl;
+      return -1;
+    }
+    stats.get.Add(elapsed);
+
+    if (ret == 0) {
+      stats.hits++;
+      if (!IsValueValid(key, value)) {
+        std::cerr << "Invalid value of key " << key << std::endl;
+        return -1;
+      }
+      continue;
+    }
+
+    stats.misses++;
+    MakeValue(key, value);
+    bool evicted = false;
+    stopwatch.Restart();
+    ret = cache.Put(key, value, evicted);
+    elapsed = stopwatch.ElapsedNs();
+
+    if (ret != 0) {
+      std::cerr << "Put of key " << key << " failed: " << pmemobj_errormsg()
+                << std::endl;
+      return -1;
+    }
+    (evicted ? stats.evicting_put : stats.put).Add(elapsed);
+  }
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_LRU_CACHE_PERF_H
+#define PMDK_TESTS_LRU_CACHE_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+#include "persistent_lru_cache.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * CacheStats -- latency and hit statistics of cache workload.
+ */
+struct CacheStats {
+  LatencyStats get;
+  LatencyStats put;
+  LatencyStats evicting_put;
+  size_t hits = 0;
+  size_t misses = 0;
+};
+
+class PmemobjLruCachePerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  cache_root *root = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "lru_cache_perf";
+  const size_t pool_size = 512 * MEBIBYTE;
+  const size_t nof_keys = 100000;
+  const size_t nof_ops = 500000;
+  const size_t min_value_size = 64;
+  const size_t max_value_size = 2 * KIBIBYTE;
+  /* cumulative probabilities of keys ordered by popularity */
+  std::vector<double> key_cdf;
+  std::mt19937_64 generator;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * OpenPool -- closes and reopens the pool. Returns 0 on success, prints
+   * error message and returns -1 otherwise.
+   */
+  int OpenPool();
+
+  /*
+   * InitKeys -- prepares Zipf distribution of nof_keys keys with given
+   * exponent, the key with rank k being chosen with probability proportional
+   * to 1 / k^skew.
+   */
+  void InitKeys(double skew);
+  uint64_t NextKey();
+
+  /*
+   * MakeValue -- fills value with content derived from the key, value size
+   * being derived from the key as well.
+   */
+  void MakeValue(uint64_t key, std::vector<char> &value) const;
+  bool IsValueValid(uint64_t key, const std::vector<char> &value) const;
+
+  /*
+   * RunWorkload -- nof_ops times gets value of a key drawn from the Zipf
+   * distribution, verifying it on hit and putting it on miss. Collects
+   * latency of operations and number of hits in stats. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int RunWorkload(PersistentLruCache &cache, CacheStats &stats);
+};
+
+class PmemobjLruCachePerfParamTest
+    : public PmemobjLruCachePerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, double>> {};
+
+#endif  // PMDK_TESTS_LRU_CACHE_PERF_H
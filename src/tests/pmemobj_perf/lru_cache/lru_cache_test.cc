@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "lru_cache.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+/**
+ * LRU_CACHE_ZIPF
+ * Parameterized Test Case: Measures hit ratio, get and put latency and
+ * eviction overhead of persistent LRU cache built on reserve/publish API
+ * with given capacity (c) for keys drawn from Zipf distribution with given
+ * exponent (s)
+ * \test
+ *          \li \c Step1. Initialize the cache with capacity c / SUCCESS
+ *          \li \c Step2. 500000 times get value of a key drawn from Zipf
+ *          distribution over 100000 keys, verifying it on hit and putting
+ *          value of 64 B to 2 KiB on miss / SUCCESS
+ *          \li \c Step3. Verify consistency of the cache
+ *          \li \c Step4. Report hit ratio, latency of gets, puts and puts
+ *          evicting an entry, and eviction overhead
+ */
+TEST_P(PmemobjLruCachePerfParamTest, LRU_CACHE_ZIPF) {
+  const size_t capacity = std::get<0>(GetParam());
+  const double skew = std::get<1>(GetParam());
+  CacheStats stats;
+
+  /* Step 1 */
+  PersistentLruCache cache(pop, root);
+  ASSERT_EQ(0, cache.Init(capacity)) << pmemobj_errormsg();
+  InitKeys(skew);
+
+  /* Step 2 */
+  Stopwatch stopwatch;
+  ASSERT_EQ(0, RunWorkload(cache, stats));
+  uint64_t elapsed = stopwatch.ElapsedNs();
+
+  /* Step 3 */
+  ASSERT_TRUE(cache.Verify());
+  ASSERT_GE(capacity, cache.Count());
+
+  /* Step 4 */
+  perf_report::Record("capacity", capacity);
+  perf_report::Record("skew", skew);
+  perf_report::Record("throughput", perf_report::OpsPerSec(nof_ops, elapsed),
+                      "ops/s");
+  perf_report::Record("hit_ratio",
+                      static_cast<double>(stats.hits) / nof_ops);
+  perf_report::RecordLatency("get", stats.get);
+  perf_report::RecordLatency("put", stats.put);
+  perf_report::RecordLatency("evicting_put", stats.evicting_put);
+  perf_report::Record("eviction_overhead",
+                      stats.evicting_put.GetMean() - stats.put.GetMean(),
+                      "ns");
+}
+
+INSTANTIATE_TEST_CASE_P(
+    LruCache, PmemobjLruCachePerfParamTest,
+    ::testing::Combine(::testing::Values(1000, 10000, 50000),
+                       ::testing::Values(0.8, 0.99, 1.2)));
+
+/**
+ * LRU_CACHE_REOPEN
+ * Test Case: Verifies that persistent LRU cache is consistent after pool
+ * reopen and measures hit ratio of the reopened cache
+ * \test
+ *          \li \c Step1. Initialize the cache with capacity 10000 / SUCCESS
+ *          \li \c Step2. Run workload with Zipf distributed keys / SUCCESS
+ *          \li \c Step3. Close and reopen the pool / SUCCESS
+ *          \li \c Step4. Verify consistency and number of entries of the
+ *          cache
+ *          \li \c Step5. Run workload again / SUCCESS
+ *          \li \c Step6. Report hit ratio before and after reopen
+ */
+TEST_F(PmemobjLruCachePerfTest, LRU_CACHE_REOPEN) {
+  const size_t capacity = 10000;
+  CacheStats stats;
+  CacheStats reopened_stats;
+
+  /* Step 1 */
+  PersistentLruCache cache(pop, root);
+  ASSERT_EQ(0, cache.Init(capacity)) << pmemobj_errormsg();
+  InitKeys(0.99);
+
+  /* Step 2 */
+  ASSERT_EQ(0, RunWorkload(cache, stats));
+  const size_t count = cache.Count();
+
+  /* Step 3 */
+  ASSERT_EQ(0, OpenPool());
+  PersistentLruCache reopened(pop, root);
+  ASSERT_EQ(0, reopened.Init(capacity)) << pmemobj_errormsg();
+
+  /* Step 4 */
+  ASSERT_TRUE(reopened.Verify());
+  ASSERT_EQ(count, reopened.Count());
+
+  /* Step 5 */
+  ASSERT_EQ(0, RunWorkload(reopened, reopened_stats));
+
+  /* Step 6 */
+  perf_report::Record("hit_ratio",
+                      static_cast<double>(stats.hits) / nof_ops);
+  perf_report::Record("reopened_hit_ratio",
+                      static_cast<double>(reopened_stats.hits) / nof_ops);
+}
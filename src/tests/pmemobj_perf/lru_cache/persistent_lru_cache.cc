@@ -0,0 +1,210 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "persistent_lru_cache.h"
+#include <cstring>
+
+uint64_t &PersistentLruCache::Bucket(uint64_t key) const {
+  return buckets_[(key * 0x9e3779b97f4a7c15ull) % root_->nof_buckets];
+}
+
+uint64_t PersistentLruCache::Find(uint64_t key) const {
+  uint64_t off = Bucket(key);
+  while (off != 0 && Direct(off)->key != key) {
+    off = Direct(off)->bucket_next;
+  }
+  return off;
+}
+
+int PersistentLruCache::Init(size_t capacity) {
+  if (OID_IS_NULL(root_->buckets)) {
+    if (capacity < 2) {
+      return -1;
+    }
+    root_->nof_buckets = 2 * capacity;
+    root_->capacity = capacity;
+    root_->count = 0;
+    root_->mru = 0;
+    root_->lru = 0;
+    pmemobj_persist(pop_, &root_->nof_buckets, 5 * sizeof(uint64_t));
+    if (pmemobj_zalloc(pop_, &root_->buckets,
+                       root_->nof_buckets * sizeof(uint64_t), 0) != 0) {
+      return -1;
+    }
+  }
+
+  buckets_ = static_cast<uint64_t *>(pmemobj_direct(root_->buckets));
+  return 0;
+}
+
+int PersistentLruCache::Get(uint64_t key, std::vector<char> &value) {
+  pobj_action actions[6];
+  size_t nof_actions = 0;
+  int ret = 0;
+
+  pmemobj_mutex_lock(pop_, &root_->lock);
+  uint64_t off = Find(key);
+  if (off == 0) {
+    pmemobj_mutex_unlock(pop_, &root_->lock);
+    return 1;
+  }
+
+  cache_entry *entry = Direct(off);
+  const char *data = reinterpret_cast<const char *>(entry + 1);
+  value.assign(data, data + entry->value_size);
+
+  if (off != root_->mru) {
+    /* unlink the entry, it has a predecessor as it is not the first one */
+    pmemobj_set_value(pop_, &actions[nof_actions++],
+                      &Direct(entry->prev)->next, entry->next);
+    if (entry->next != 0) {
+      pmemobj_set_value(pop_, &actions[nof_actions++],
+                        &Direct(entry->next)->prev, entry->prev);
+    } else {
+      pmemobj_set_value(pop_, &actions[nof_actions++], &root_->lru,
+                        entry->prev);
+    }
+
+    /* link it at the front */
+    pmemobj_set_value(pop_, &actions[nof_actions++], &entry->prev, 0);
+    pmemobj_set_value(pop_, &actions[nof_actions++], &entry->next,
+                      root_->mru);
+    pmemobj_set_value(pop_, &actions[nof_actions++],
+                      &Direct(root_->mru)->prev, off);
+    pmemobj_set_value(pop_, &actions[nof_actions++], &root_->mru, off);
+    ret = pmemobj_publish(pop_, actions, nof_actions);
+    if (ret != 0) {
+      pmemobj_cancel(pop_, actions, nof_actions);
+    }
+  }
+  pmemobj_mutex_unlock(pop_, &root_->lock);
+
+  return ret;
+}
+
+int PersistentLruCache::Put(uint64_t key, const std::vector<char> &value,
+                            bool &evicted) {
+  pobj_action actions[9];
+  size_t nof_actions = 0;
+
+  PMEMoid oid = pmemobj_reserve(pop_, &actions[nof_actions++],
+                                sizeof(cache_entry) + value.size(), 0);
+  if (OID_IS_NULL(oid)) {
+    return -1;
+  }
+  cache_entry *entry = static_cast<cache_entry *>(pmemobj_direct(oid));
+  entry->key = key;
+  entry->value_size = value.size();
+  memcpy(entry + 1, value.data(), value.size());
+
+  pmemobj_mutex_lock(pop_, &root_->lock);
+  if (Find(key) != 0) {
+    pmemobj_mutex_unlock(pop_, &root_->lock);
+    pmemobj_cancel(pop_, actions, nof_actions);
+    return 1;
+  }
+
+  uint64_t &bucket = Bucket(key);
+  uint64_t chain_head = bucket;
+  evicted = root_->count >= root_->capacity;
+
+  if (evicted) {
+    cache_entry *victim = Direct(root_->lru);
+
+    /* unlink the victim from its hash chain */
+    uint64_t &victim_bucket = Bucket(victim->key);
+    if (victim_bucket == root_->lru) {
+      if (&victim_bucket == &bucket) {
+        chain_head = victim->bucket_next;
+      } else {
+        pmemobj_set_value(pop_, &actions[nof_actions++], &victim_bucket,
+                          victim->bucket_next);
+      }
+    } else {
+      cache_entry *pred = Direct(victim_bucket);
+      while (pred->bucket_next != root_->lru) {
+        pred = Direct(pred->bucket_next);
+      }
+      pmemobj_set_value(pop_, &actions[nof_actions++], &pred->bucket_next,
+                        victim->bucket_next);
+    }
+
+    /* unlink it from the end of the recency list, capacity is at least 2 */
+    pmemobj_set_value(pop_, &actions[nof_actions++], &root_->lru,
+                      victim->prev);
+    pmemobj_set_value(pop_, &actions[nof_actions++],
+                      &Direct(victim->prev)->next, 0);
+    pmemobj_defer_free(pop_, pmemobj_oid(victim), &actions[nof_actions++]);
+  }
+
+  entry->bucket_next = chain_head;
+  entry->prev = 0;
+  entry->next = root_->mru;
+  pmemobj_persist(pop_, entry, sizeof(cache_entry) + value.size());
+
+  pmemobj_set_value(pop_, &actions[nof_actions++], &bucket, oid.off);
+  if (root_->mru != 0) {
+    pmemobj_set_value(pop_, &actions[nof_actions++],
+                      &Direct(root_->mru)->prev, oid.off);
+  } else {
+    pmemobj_set_value(pop_, &actions[nof_actions++], &root_->lru, oid.off);
+  }
+  pmemobj_set_value(pop_, &actions[nof_actions++], &root_->mru, oid.off);
+  if (!evicted) {
+    pmemobj_set_value(pop_, &actions[nof_actions++], &root_->count,
+                      root_->count + 1);
+  }
+  int ret = pmemobj_publish(pop_, actions, nof_actions);
+  if (ret != 0) {
+    pmemobj_cancel(pop_, actions, nof_actions);
+  }
+  pmemobj_mutex_unlock(pop_, &root_->lock);
+
+  return ret;
+}
+
+bool PersistentLruCache::Verify() const {
+  uint64_t prev = 0;
+  size_t count = 0;
+
+  for (uint64_t off = root_->mru; off != 0; off = Direct(off)->next) {
+    const cache_entry *entry = Direct(off);
+    if (entry->prev != prev || Find(entry->key) != off ||
+        ++count > root_->capacity) {
+      return false;
+    }
+    prev = off;
+  }
+
+  return prev == root_->lru && count == root_->count;
+}
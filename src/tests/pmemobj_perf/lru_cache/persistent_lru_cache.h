@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_PERSISTENT_LRU_CACHE_H
+#define PMDK_TESTS_PERSISTENT_LRU_CACHE_H
+
+#include <libpmemobj.h>
+#include <vector>
+
+/*
+ * cache_entry -- header of a cache entry, followed by value_size bytes of
+ * the value. Links are stored as offsets from the pool base (0 for none), so
+ * that each of them can be updated with a single pmemobj_set_value action.
+ */
+struct cache_entry {
+  uint64_t bucket_next;
+  /* neighbour closer to the most recently used entry */
+  uint64_t prev;
+  /* neighbour closer to the least recently used entry */
+  uint64_t next;
+  uint64_t key;
+  uint64_t value_size;
+};
+
+/*
+ * cache_root -- persistent part of the cache. Buckets is an array of
+ * nof_buckets offsets of first entries of hash chains, mru and lru are ends
+ * of the recency list.
+ */
+struct cache_root {
+  PMEMoid buckets;
+  uint64_t nof_buckets;
+  uint64_t capacity;
+  uint64_t count;
+  uint64_t mru;
+  uint64_t lru;
+  PMEMmutex lock;
+};
+
+/*
+ * PersistentLruCache -- LRU cache with a hash index and a recency list kept
+ * in the pool. Put reserves and fills new entry without locking and
+ * publishes it together with pmemobj_set_value actions linking it into its
+ * hash chain and at the front of the recency list. When the cache is full,
+ * the same publication unlinks the least recently used entry and releases it
+ * with pmemobj_defer_free. Get publishes pmemobj_set_value actions moving
+ * the entry to the front of the recency list. Each operation is therefore
+ * failure atomic and the cache is consistent after pool reopen.
+ */
+class PersistentLruCache final {
+ private:
+  PMEMobjpool *pop_;
+  cache_root *root_;
+  uint64_t *buckets_ = nullptr;
+
+  cache_entry *Direct(uint64_t off) const {
+    return off == 0 ? nullptr
+                    : reinterpret_cast<cache_entry *>(
+                          reinterpret_cast<char *>(pop_) + off);
+  }
+
+  uint64_t &Bucket(uint64_t key) const;
+
+  /*
+   * Find -- returns offset of the entry with given key or 0 if there is no
+   * such entry.
+   */
+  uint64_t Find(uint64_t key) const;
+
+ public:
+  PersistentLruCache(PMEMobjpool *pop, cache_root *root)
+      : pop_(pop), root_(root) {
+  }
+
+  /*
+   * Init -- allocates hash index for cache of given capacity (at least 2
+   * entries) if the cache was not initialized yet. Returns 0 on success, -1
+   * otherwise.
+   */
+  int Init(size_t capacity);
+
+  /*
+   * Get -- copies value of the entry with given key to value and marks the
+   * entry as the most recently used. Returns 0 on hit, 1 on miss and -1 on
+   * error.
+   */
+  int Get(uint64_t key, std::vector<char> &value);
+
+  /*
+   * Put -- inserts entry with given key and value, evicting the least
+   * recently used entry if the cache is full. Sets evicted accordingly.
+   * Returns 0 on success, 1 if the key is already cached and -1 on error.
+   */
+  int Put(uint64_t key, const std::vector<char> &value, bool &evicted);
+
+  size_t Count() const {
+    return root_->count;
+  }
+
+  /*
+   * Verify -- checks that the recency list is consistent with the hash index
+   * and the number of entries. Not thread-safe.
+   */
+  bool Verify() const;
+};
+
+#endif  // PMDK_TESTS_PERSISTENT_LRU_CACHE_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem_flags.h"
+#include <algorithm>
+#include <future>
+#include <thread>
+#include "perf/stopwatch.h"
+
+void PmemobjMemFlagsPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  if (!pool_path_.empty()) {
+    ApiC::RemoveFile(pool_path_);
+  }
+}
+
+std::vector<size_t> PmemobjMemFlagsPerfTest::GetThreadCounts() const {
+  size_t hw_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<size_t> thread_counts;
+
+  for (size_t threads = 1; threads < hw_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(hw_threads);
+
+  return thread_counts;
+}
+
+unsigned PmemobjMemFlagsPerfTest::GetFlags(unsigned index) const {
+  unsigned flags = 0;
+  for (size_t i = 0; i < mem_flags.size(); i++) {
+    if (index & (1u << i)) {
+      flags |= mem_flags[i];
+    }
+  }
+  return flags;
+}
+
+std::string PmemobjMemFlagsPerfTest::FlagsToString(unsigned index) const {
+  std::string names;
+  for (size_t i = 0; i < mem_flag_names.size(); i++) {
+    if (index & (1u << i)) {
+      names += (names.empty() ? "" : "|") + mem_flag_names[i];
+    }
+  }
+  return names.empty() ? "0" : names;
+}
+
+double PmemobjMemFlagsPerfTest::MeasureBandwidth(
+    MemOp op, unsigned flags, size_t size, const std::vector<char *> &dests,
+    const char *src) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<void>> workers;
+  size_t iterations = std::max(size_t{1}, bytes_per_thread / size);
+
+  for (char *dest : dests) {
+    workers.push_back(std::async(std::launch::async, [&, dest, started]() {
+      started.wait();
+      for (size_t i = 0; i < iterations; i++) {
+        char *range = dest + (i * size) % max_size;
+        if (op == MemOp::MEMCPY) {
+          pmemobj_memcpy(pop, range, src, size, flags);
+        } else {
+          pmemobj_memset(pop, range, static_cast<int>(i), size, flags);
+        }
+      }
+      pmemobj_drain(pop);
+    }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &worker : workers) {
+    worker.get();
+  }
+  double elapsed_sec = total.ElapsedSec();
+
+  return static_cast<double>(dests.size() * iterations * size) / MEBIBYTE /
+         elapsed_sec;
+}
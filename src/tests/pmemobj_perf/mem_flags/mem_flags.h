@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_MEM_FLAGS_PERF_H
+#define PMDK_TESTS_MEM_FLAGS_PERF_H
+
+#include <libpmemobj.h>
+#include <array>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/pool_location.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+enum class MemOp { MEMCPY, MEMSET };
+
+class PmemobjMemFlagsPerfTest : public ::testing::Test {
+ protected:
+  PMEMobjpool *pop = nullptr;
+  std::string pool_path_;
+  const std::string layout_ = "mem_flags_perf";
+  const size_t min_size = 64;
+  const size_t max_size = 64 * MEBIBYTE;
+  /* number of bytes written by each thread in a single measurement */
+  const size_t bytes_per_thread = 64 * MEBIBYTE;
+  const std::array<unsigned, 6> mem_flags = {
+      {PMEMOBJ_F_MEM_NODRAIN, PMEMOBJ_F_MEM_NONTEMPORAL, PMEMOBJ_F_MEM_TEMPORAL,
+       PMEMOBJ_F_MEM_WC, PMEMOBJ_F_MEM_WB, PMEMOBJ_F_MEM_NOFLUSH}};
+  const std::array<std::string, 6> mem_flag_names = {
+      {"NODRAIN", "NONTEMPORAL", "TEMPORAL", "WC", "WB", "NOFLUSH"}};
+
+ public:
+  void TearDown() override;
+
+  /*
+   * GetThreadCounts -- returns powers of 2 lower than the number of hardware
+   * threads followed by the number of hardware threads.
+   */
+  std::vector<size_t> GetThreadCounts() const;
+
+  /*
+   * GetFlags -- converts combination index to PMEMOBJ_F_MEM_* flags, where
+   * each bit of the index selects one of the flags.
+   */
+  unsigned GetFlags(unsigned index) const;
+  std::string FlagsToString(unsigned index) const;
+
+  /*
+   * MeasureBandwidth -- performs op with given flags on size bytes in a
+   * separate thread for each of dests until each thread writes
+   * bytes_per_thread bytes. Returns bandwidth in MiB/s.
+   */
+  double MeasureBandwidth(MemOp op, unsigned flags, size_t size,
+                          const std::vector<char *> &dests, const char *src);
+};
+
+class PmemobjMemFlagsPerfParamTest
+    : public PmemobjMemFlagsPerfTest,
+      public ::testing::WithParamInterface<std::tuple<MemOp, unsigned>> {};
+
+#endif  // PMDK_TESTS_MEM_FLAGS_PERF_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem_flags.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+
+/**
+ * PMEMOBJ_MEM_FLAGS_BANDWIDTH
+ * Parameterized Test Case: Measures bandwidth of pmemobj_memcpy and
+ * pmemobj_memset for combinations of PMEMOBJ_F_MEM_* flags on pools created in
+ * test directory and on each NVDIMM mountpoint. Parameters are:
+ *  - the operation (pmemobj_memcpy or pmemobj_memset)
+ *  - the combination of PMEMOBJ_F_MEM_* flags
+ * \test
+ *          \li \c Step1. Create the pmemobj pool file in the next location
+ *          / SUCCESS
+ *          \li \c Step2. Allocate 64 MiB destination object per thread
+ *          / SUCCESS
+ *          \li \c Step3. For sizes from 64 B to 64 MiB and thread counts from 1
+ *          to the number of hardware threads measure bandwidth of the
+ *          operation with given flags
+ *          \li \c Step4. Close and remove the pool
+ *          \li \c Step5. Repeat steps 1-4 for all locations
+ */
+TEST_P(PmemobjMemFlagsPerfParamTest, PMEMOBJ_MEM_FLAGS_BANDWIDTH) {
+  const MemOp op = std::get<0>(GetParam());
+  const unsigned flags = GetFlags(std::get<1>(GetParam()));
+  const std::vector<size_t> thread_counts = GetThreadCounts();
+  const size_t max_threads = thread_counts.back();
+  const size_t pool_size = 64 * MEBIBYTE + max_threads * (max_size + MEBIBYTE);
+  const std::vector<char> src(max_size, 'x');
+
+  perf_report::Record("op", op == MemOp::MEMCPY ? "memcpy" : "memset");
+  perf_report::Record("flags", FlagsToString(std::get<1>(GetParam())));
+
+  for (const auto &location :
+       perf_utils::GetPoolLocations(*local_config, "pmdk_tests_perf_pool")) {
+    if (!perf_utils::HasFreeSpace(location.dir, pool_size)) {
+      continue;
+    }
+
+    /* Step 1 */
+    pool_path_ = location.pool_path;
+    ApiC::RemoveFile(pool_path_);
+    pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                         S_IWRITE | S_IREAD);
+    ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+
+    /* Step 2 */
+    std::vector<char *> dests;
+    for (size_t th = 0; th < max_threads; th++) {
+      PMEMoid oid;
+      ASSERT_EQ(0, pmemobj_alloc(pop, &oid, max_size, 0, nullptr, nullptr))
+          << pmemobj_errormsg();
+      dests.push_back(static_cast<char *>(pmemobj_direct(oid)));
+    }
+
+    /* Step 3 */
+    for (size_t size = min_size; size <= max_size; size *= 4) {
+      for (size_t threads : thread_counts) {
+        std::vector<char *> thread_dests(dests.begin(),
+                                         dests.begin() + threads);
+        double bandwidth =
+            MeasureBandwidth(op, flags, size, thread_dests, src.data());
+        perf_report::Record(location.name + "_size_" + std::to_string(size) +
+                                "_threads_" + std::to_string(threads),
+                            bandwidth, "MiB/s");
+      }
+    }
+
+    /* Step 4 */
+    pmemobj_close(pop);
+    pop = nullptr;
+    ApiC::RemoveFile(pool_path_);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    MemFlagsPerfParam, PmemobjMemFlagsPerfParamTest,
+    ::testing::Combine(::testing::Values(MemOp::MEMCPY, MemOp::MEMSET),
+                       ::testing::Range(0u, 64u)));
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "multi_pool.h"
+#include <future>
+#include <random>
+#include "perf/stopwatch.h"
+
+void PmemobjMultiPoolPerfTest::TearDown() {
+  for (auto pop : pools_) {
+    pmemobj_close(pop);
+  }
+  for (const auto &path : pool_paths_) {
+    ApiC::RemoveFile(path);
+  }
+}
+
+int PmemobjMultiPoolPerfTest::CreatePools(size_t nof_pools, size_t pool_size) {
+  for (size_t i = 0; i < nof_pools; ++i) {
+    std::string path = test_dir_ + "pool" + std::to_string(i);
+    ApiC::RemoveFile(path);
+    PMEMobjpool *pop = pmemobj_create(path.c_str(), layout_.c_str(),
+                                      pool_size, S_IWRITE | S_IREAD);
+    if (pop == nullptr) {
+      std::cerr << "Pool creation failed: " << pmemobj_errormsg()
+                << std::endl;
+      return -1;
+    }
+    pool_paths_.push_back(path);
+    pools_.push_back(pop);
+  }
+
+  return 0;
+}
+
+void PmemobjMultiPoolPerfTest::ClosePools() {
+  for (auto pop : pools_) {
+    pmemobj_close(pop);
+  }
+  pools_.clear();
+}
+
+int PmemobjMultiPoolPerfTest::OpenPools() {
+  for (const auto &path : pool_paths_) {
+    PMEMobjpool *pop = pmemobj_open(path.c_str(), layout_.c_str());
+    if (pop == nullptr) {
+      std::cerr << "Pool opening failed: " << pmemobj_errormsg() << std::endl;
+      return -1;
+    }
+    pools_.push_back(pop);
+  }
+
+  return 0;
+}
+
+int PmemobjMultiPoolPerfTest::RunOperations(
+    const std::vector<PMEMobjpool *> &pools, unsigned seed) {
+  std::vector<PMEMoid> live(window_size, OID_NULL);
+  std::vector<char> update(update_size, static_cast<char>(seed));
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<size_t> index(0, window_size - 1);
+  int ret = 0;
+
+  for (size_t i = 0; i < ops_per_thread; ++i) {
+    PMEMoid &oldest = live[i % window_size];
+    if (!OID_IS_NULL(oldest)) {
+      pmemobj_free(&oldest);
+    }
+    if (pmemobj_alloc(pools[i % pools.size()], &oldest, object_size, 0,
+                      nullptr, nullptr) != 0) {
+      ret = -1;
+      break;
+    }
+
+    PMEMoid target = live[index(generator)];
+    if (!OID_IS_NULL(target)) {
+      pmemobj_memcpy_persist(pmemobj_pool_by_oid(target),
+                             pmemobj_direct(target), update.data(),
+                             update_size);
+    }
+  }
+
+  for (auto &oid : live) {
+    if (!OID_IS_NULL(oid)) {
+      pmemobj_free(&oid);
+    }
+  }
+  return ret;
+}
+
+uint64_t PmemobjMultiPoolPerfTest::RunWorkload(
+    size_t nof_threads,
+    const std::vector<std::vector<PMEMobjpool *>> &pools_per_thread) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<int>> future_rets;
+
+  for (size_t i = 0; i < nof_threads; ++i) {
+    future_rets.push_back(
+        std::async(std::launch::async, [this, i, started, &pools_per_thread]() {
+          started.wait();
+          return RunOperations(pools_per_thread[i], static_cast<unsigned>(i));
+        }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &future_ret : future_rets) {
+    EXPECT_EQ(0, future_ret.get()) << pmemobj_errormsg();
+  }
+  return total.ElapsedNs();
+}
+
+bool PmemobjMultiPoolPerfTest::AllPoolsEmpty() const {
+  for (auto pop : pools_) {
+    if (!OID_IS_NULL(pmemobj_first(pop))) {
+      return false;
+    }
+  }
+  return true;
+}
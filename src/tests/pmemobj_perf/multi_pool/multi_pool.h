@@ -0,0 +1,122 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_MULTI_POOL_PERF_H
+#define PMDK_TESTS_MULTI_POOL_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * PoolLayout -- assignment of pools to threads:
+ *  - SHARED - all threads use a single pool
+ *  - PRIVATE - each thread uses its own pool
+ */
+enum class PoolLayout { SHARED, PRIVATE };
+
+class PmemobjMultiPoolPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  std::vector<PMEMobjpool *> pools_;
+  std::vector<std::string> pool_paths_;
+  const std::string layout_ = "multi_pool_perf";
+  const size_t object_size = 128;
+  const size_t update_size = 64;
+  /* number of live objects kept by each thread */
+  const size_t window_size = 64;
+  const size_t ops_per_thread = 100000;
+
+ public:
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  /*
+   * CreatePools -- creates nof_pools pools of given size. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  int CreatePools(size_t nof_pools, size_t pool_size);
+
+  /*
+   * ClosePools -- closes all created pools, keeping their files.
+   */
+  void ClosePools();
+
+  /*
+   * OpenPools -- opens all pools closed by ClosePools. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int OpenPools();
+
+  /*
+   * RunWorkload -- runs ops_per_thread operations in each of nof_threads
+   * threads. In each operation a thread frees its oldest live object,
+   * allocates a new one and updates randomly chosen live object, using pool
+   * from pools_per_thread[thread] chosen round-robin for allocations. Threads
+   * free all objects at the end. Returns total execution time in nanoseconds.
+   */
+  uint64_t RunWorkload(
+      size_t nof_threads,
+      const std::vector<std::vector<PMEMobjpool *>> &pools_per_thread);
+
+  /*
+   * RunOperations -- performs operations of a single thread. Returns 0 on
+   * success, -1 otherwise.
+   */
+  int RunOperations(const std::vector<PMEMobjpool *> &pools, unsigned seed);
+
+  /*
+   * AllPoolsEmpty -- checks that there are no objects in any of created
+   * pools.
+   */
+  bool AllPoolsEmpty() const;
+};
+
+class PmemobjMultiPoolLayoutPerfParamTest
+    : public PmemobjMultiPoolPerfTest,
+      public ::testing::WithParamInterface<std::tuple<PoolLayout, size_t>> {};
+
+class PmemobjManyPoolsPerfParamTest
+    : public PmemobjMultiPoolPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+#endif  // PMDK_TESTS_MULTI_POOL_PERF_H
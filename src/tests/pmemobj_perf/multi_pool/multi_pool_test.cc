@@ -0,0 +1,158 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "multi_pool.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "perf/stopwatch.h"
+
+/**
+ * MULTI_POOL_LAYOUT
+ * Parameterized Test Case: Measures throughput of allocate/update workload
+ * run by given number of threads (n) on a single shared pool or on private
+ * pool of each thread, depending on given layout (l)
+ * \test
+ *          \li \c Step1. Create 32 MiB pool (l = SHARED) or n 32 MiB pools
+ *          (l = PRIVATE) / SUCCESS
+ *          \li \c Step2. Run 100000 operations in each of n threads, each
+ *          operation freeing the oldest of 64 live objects of the thread,
+ *          allocating 128 B object and updating 64 B of randomly chosen live
+ *          object / SUCCESS
+ *          \li \c Step3. Verify that no objects are left in the pools
+ *          \li \c Step4. Report throughput
+ */
+TEST_P(PmemobjMultiPoolLayoutPerfParamTest, MULTI_POOL_LAYOUT) {
+  const PoolLayout layout = std::get<0>(GetParam());
+  const size_t nof_threads = std::get<1>(GetParam());
+  const size_t pool_size = 32 * MEBIBYTE;
+  const size_t nof_pools = layout == PoolLayout::SHARED ? 1 : nof_threads;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), nof_pools * pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePools(nof_pools, pool_size));
+  std::vector<std::vector<PMEMobjpool *>> pools_per_thread;
+  for (size_t i = 0; i < nof_threads; ++i) {
+    pools_per_thread.push_back({pools_[i % nof_pools]});
+  }
+
+  /* Step 2 */
+  uint64_t elapsed = RunWorkload(nof_threads, pools_per_thread);
+
+  /* Step 3 */
+  ASSERT_TRUE(AllPoolsEmpty());
+
+  /* Step 4 */
+  perf_report::Record("layout",
+                      layout == PoolLayout::SHARED ? "shared" : "private");
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record(
+      "throughput",
+      perf_report::OpsPerSec(nof_threads * ops_per_thread, elapsed), "ops/s");
+}
+
+INSTANTIATE_TEST_CASE_P(
+    MultiPool, PmemobjMultiPoolLayoutPerfParamTest,
+    ::testing::Combine(::testing::Values(PoolLayout::SHARED,
+                                         PoolLayout::PRIVATE),
+                       ::testing::Values(1, 2, 4, 8, 16)));
+
+/**
+ * MULTI_POOL_MANY_OPEN_POOLS
+ * Parameterized Test Case: Measures memory overhead of open pools and
+ * throughput of allocate/update workload spread over given number of open
+ * pools (p), which stresses translation of object IDs in pmemobj_direct and
+ * pmemobj_pool_by_oid
+ * \test
+ *          \li \c Step1. Create p pools of minimal size measuring creation
+ *          time, close them and open them again measuring opening time and
+ *          resident memory of the process before and after opening / SUCCESS
+ *          \li \c Step2. Run 100000 operations in each of 4 threads, each
+ *          operation freeing the oldest of 64 live objects of the thread,
+ *          allocating 128 B object in the next of p pools and updating 64 B
+ *          of randomly chosen live object / SUCCESS
+ *          \li \c Step3. Verify that no objects are left in the pools
+ *          \li \c Step4. Report throughput, mean pool creation and opening
+ *          time and resident memory per open pool
+ */
+TEST_P(PmemobjManyPoolsPerfParamTest, MULTI_POOL_MANY_OPEN_POOLS) {
+  const size_t nof_pools = GetParam();
+  const size_t nof_threads = 4;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), nof_pools * PMEMOBJ_MIN_POOL)) {
+    return;
+  }
+
+  /* Step 1 */
+  Stopwatch stopwatch;
+  ASSERT_EQ(0, CreatePools(nof_pools, PMEMOBJ_MIN_POOL));
+  uint64_t create_elapsed = stopwatch.ElapsedNs();
+  /* formatting touches pages of pool files, so measure opening only */
+  ClosePools();
+  size_t memory_before = perf_utils::GetResidentMemory();
+  stopwatch.Restart();
+  ASSERT_EQ(0, OpenPools());
+  uint64_t open_elapsed = stopwatch.ElapsedNs();
+  size_t memory_after = perf_utils::GetResidentMemory();
+
+  std::vector<std::vector<PMEMobjpool *>> pools_per_thread(nof_threads);
+  for (size_t i = 0; i < nof_threads; ++i) {
+    for (size_t j = 0; j < nof_pools; ++j) {
+      pools_per_thread[i].push_back(pools_[(i + j) % nof_pools]);
+    }
+  }
+
+  /* Step 2 */
+  uint64_t elapsed = RunWorkload(nof_threads, pools_per_thread);
+
+  /* Step 3 */
+  ASSERT_TRUE(AllPoolsEmpty());
+
+  /* Step 4 */
+  perf_report::Record("pools", nof_pools);
+  perf_report::Record(
+      "throughput",
+      perf_report::OpsPerSec(nof_threads * ops_per_thread, elapsed), "ops/s");
+  perf_report::Record("pool_create_mean",
+                      static_cast<double>(create_elapsed) / nof_pools, "ns");
+  perf_report::Record("pool_open_mean",
+                      static_cast<double>(open_elapsed) / nof_pools, "ns");
+  perf_report::Record(
+      "memory_per_pool",
+      (static_cast<double>(memory_after) - memory_before) / nof_pools, "B");
+}
+
+INSTANTIATE_TEST_CASE_P(MultiPool, PmemobjManyPoolsPerfParamTest,
+                        ::testing::Values(1, 16, 64, 256));
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "noisy_neighbour.h"
+#include <libpmem.h>
+#include <cstring>
+#include <utility>
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+
+void PmemobjNoisyNeighbourPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  ApiC::RemoveFile(noise_path_);
+}
+
+void PmemobjNoisyNeighbourPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  if (noise_ != nullptr) {
+    pmem_unmap(noise_, noise_len_);
+  }
+  ApiC::RemoveFile(pool_path_);
+  ApiC::RemoveFile(noise_path_);
+}
+
+int PmemobjNoisyNeighbourPerfTest::CreateFiles() {
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  if (pop == nullptr) {
+    std::cerr << "Pool creation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  if (pmemobj_zalloc(pop, &object_, object_size, 0) != 0) {
+    std::cerr << "Allocation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  int is_pmem = 0;
+  noise_ = static_cast<char *>(pmem_map_file(noise_path_.c_str(), noise_size,
+                                             PMEM_FILE_CREATE,
+                                             S_IWRITE | S_IREAD, &noise_len_,
+                                             &is_pmem));
+  if (noise_ == nullptr) {
+    std::cerr << "Mapping noise file failed: " << pmem_errormsg()
+              << std::endl;
+    return -1;
+  }
+  pmem_memset_persist(noise_, 0xff, noise_len_);
+
+  return 0;
+}
+
+double PmemobjNoisyNeighbourPerfTest::RunNoise(NoiseMode mode,
+                                               size_t thread_id,
+                                               size_t nof_threads,
+                                               const std::atomic<bool> &stop) {
+  const size_t nof_chunks = noise_len_ / noise_chunk_size / nof_threads;
+  char *region = noise_ + thread_id * nof_chunks * noise_chunk_size;
+  std::vector<char> buffer(noise_chunk_size, static_cast<char>(thread_id));
+  uint64_t copied = 0;
+
+  Stopwatch stopwatch;
+  for (size_t i = 0; !stop; i = (i + 1) % nof_chunks) {
+    char *chunk = region + i * noise_chunk_size;
+    if (mode == NoiseMode::WRITE) {
+      pmem_memcpy_persist(chunk, buffer.data(), noise_chunk_size);
+    } else {
+      memcpy(buffer.data(), chunk, noise_chunk_size);
+    }
+    copied += noise_chunk_size;
+  }
+
+  return static_cast<double>(copied) / MEBIBYTE / stopwatch.ElapsedSec();
+}
+
+int PmemobjNoisyNeighbourPerfTest::MeasureForeground(
+    LatencyStats &reserve_stats, LatencyStats &tx_stats) {
+  auto data = static_cast<char *>(pmemobj_direct(object_));
+  std::vector<PMEMoid> objects;
+  int ret = 0;
+
+  objects.reserve(nof_samples);
+  reserve_stats.Reserve(nof_samples);
+  tx_stats.Reserve(nof_samples);
+  for (size_t i = 0; i < nof_samples && ret == 0; ++i) {
+    pobj_action act;
+
+    Stopwatch stopwatch;
+    PMEMoid oid = pmemobj_reserve(pop, &act, object_size, 0);
+    if (OID_IS_NULL(oid) || pmemobj_publish(pop, &act, 1) != 0) {
+      std::cerr << "Reservation failed: " << pmemobj_errormsg() << std::endl;
+      ret = -1;
+      break;
+    }
+    reserve_stats.Add(stopwatch.ElapsedNs());
+    objects.push_back(oid);
+
+    stopwatch.Restart();
+    TX_BEGIN(pop) {
+      pmemobj_tx_add_range(object_, 0, object_size);
+      memset(data, static_cast<int>(i), object_size);
+    }
+    TX_ONABORT {
+      std::cerr << "Transaction aborted: " << pmemobj_errormsg() << std::endl;
+      ret = -1;
+    }
+    TX_END
+
+    if (ret == 0) {
+      tx_stats.Add(stopwatch.ElapsedNs());
+    }
+  }
+
+  for (auto &oid : objects) {
+    pmemobj_free(&oid);
+  }
+  return ret;
+}
+
+void PmemobjNoisyNeighbourPerfTest::RecordDegradation(
+    const std::string &prefix, LatencyStats &baseline, LatencyStats &loaded) {
+  const std::vector<std::pair<std::string, double>> percentiles = {
+      {"p50", 50}, {"p99", 99}, {"p99.9", 99.9}};
+
+  for (const auto &percentile : percentiles) {
+    uint64_t base = baseline.GetPercentile(percentile.second);
+    if (base == 0) {
+      continue;
+    }
+    perf_report::Record(
+        prefix + "_" + percentile.first + "_degradation",
+        static_cast<double>(loaded.GetPercentile(percentile.second)) / base);
+  }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_NOISY_NEIGHBOUR_PERF_H
+#define PMDK_TESTS_NOISY_NEIGHBOUR_PERF_H
+
+#include <libpmemobj.h>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * NoiseMode -- kind of background load:
+ *  - WRITE - pmem_memcpy_persist from DRAM to the noise file
+ *  - READ - memcpy from the noise file to DRAM
+ */
+enum class NoiseMode { WRITE, READ };
+
+class PmemobjNoisyNeighbourPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  PMEMoid object_ = OID_NULL;
+  char *noise_ = nullptr;
+  size_t noise_len_ = 0;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string noise_path_ = test_dir_ + "noise";
+  const std::string layout_ = "noisy_neighbour_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  /* size of the file written or read by background threads */
+  const size_t noise_size = GIGIBYTE;
+  /* number of bytes copied by background thread in a single call */
+  const size_t noise_chunk_size = 2 * MEBIBYTE;
+  const size_t object_size = 256;
+  const size_t nof_samples = 100000;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  /*
+   * CreateFiles -- creates pool with object modified in transactions, maps
+   * noise file of noise_size bytes and fills it, so that reads of the file
+   * reach the media instead of unwritten extents. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int CreateFiles();
+
+  /*
+   * RunNoise -- copies noise_chunk_size bytes between DRAM and thread's part
+   * of the noise file according to mode until stop is set. Returns bandwidth
+   * of the thread in MiB/s measured over its own run.
+   */
+  double RunNoise(NoiseMode mode, size_t thread_id, size_t nof_threads,
+                  const std::atomic<bool> &stop);
+
+  /*
+   * MeasureForeground -- nof_samples times reserves and publishes object of
+   * object_size, and modifies object in a transaction, collecting latency of
+   * both operations. Frees published objects. Returns 0 on success, prints
+   * error message and returns -1 otherwise.
+   */
+  int MeasureForeground(LatencyStats &reserve_stats, LatencyStats &tx_stats);
+
+  /*
+   * RecordDegradation -- reports ratio of selected percentiles with
+   * background load to the ones without it.
+   */
+  void RecordDegradation(const std::string &prefix, LatencyStats &baseline,
+                         LatencyStats &loaded);
+};
+
+class PmemobjNoisyNeighbourPerfParamTest
+    : public PmemobjNoisyNeighbourPerfTest,
+      public ::testing::WithParamInterface<std::tuple<NoiseMode, size_t>> {};
+
+#endif  // PMDK_TESTS_NOISY_NEIGHBOUR_PERF_H
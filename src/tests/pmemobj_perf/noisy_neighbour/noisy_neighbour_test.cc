@@ -0,0 +1,112 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <future>
+#include "noisy_neighbour.h"
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+
+/**
+ * NOISY_NEIGHBOUR
+ * Parameterized Test Case: Measures how latency of reservations and
+ * transactions degrades when given number (t) of background threads write
+ * or read (m) a file in the same directory as the pool
+ * \test
+ *          \li \c Step1. Create pool, map and fill 1 GiB noise file (skip if
+ *          there is not enough free space) / SUCCESS
+ *          \li \c Step2. 100000 times reserve and publish 256 B object and
+ *          modify 256 B object in a transaction measuring latency of both
+ *          operations without background load / SUCCESS
+ *          \li \c Step3. Start t threads copying 2 MiB chunks to the noise
+ *          file with pmem_memcpy_persist (WRITE) or from the noise file to
+ *          DRAM (READ) / SUCCESS
+ *          \li \c Step4. Repeat measurements from step 2 with background
+ *          load / SUCCESS
+ *          \li \c Step5. Stop background threads
+ *          \li \c Step6. Report latencies with and without background load,
+ *          their degradation and sum of bandwidths measured by background
+ *          threads over their own runs
+ */
+TEST_P(PmemobjNoisyNeighbourPerfParamTest, NOISY_NEIGHBOUR) {
+  const NoiseMode mode = std::get<0>(GetParam());
+  const size_t nof_threads = std::get<1>(GetParam());
+  LatencyStats baseline_reserve_stats;
+  LatencyStats baseline_tx_stats;
+  LatencyStats reserve_stats;
+  LatencyStats tx_stats;
+  std::vector<std::future<double>> noise_threads;
+  std::atomic<bool> stop{false};
+  double noise_bandwidth = 0;
+
+  /* Step 1 */
+  if (!perf_utils::HasFreeSpace(GetTestDir(), pool_size + noise_size)) {
+    return;
+  }
+  ASSERT_EQ(0, CreateFiles());
+
+  /* Step 2 */
+  ASSERT_EQ(0, MeasureForeground(baseline_reserve_stats, baseline_tx_stats));
+
+  /* Step 3 */
+  for (size_t i = 0; i < nof_threads; ++i) {
+    noise_threads.push_back(std::async(std::launch::async, [&, i]() {
+      return RunNoise(mode, i, nof_threads, stop);
+    }));
+  }
+
+  /* Step 4 */
+  int ret = MeasureForeground(reserve_stats, tx_stats);
+
+  /* Step 5 */
+  stop = true;
+  for (auto &noise_thread : noise_threads) {
+    noise_bandwidth += noise_thread.get();
+  }
+  ASSERT_EQ(0, ret);
+
+  /* Step 6 */
+  perf_report::Record("mode", mode == NoiseMode::WRITE ? "WRITE" : "READ");
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("noise_bandwidth", noise_bandwidth, "MiB/s");
+  perf_report::RecordLatency("baseline_reserve", baseline_reserve_stats);
+  perf_report::RecordLatency("baseline_tx", baseline_tx_stats);
+  perf_report::RecordLatency("reserve", reserve_stats);
+  perf_report::RecordLatency("tx", tx_stats);
+  RecordDegradation("reserve", baseline_reserve_stats, reserve_stats);
+  RecordDegradation("tx", baseline_tx_stats, tx_stats);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    NoisyNeighbour, PmemobjNoisyNeighbourPerfParamTest,
+    ::testing::Combine(::testing::Values(NoiseMode::WRITE, NoiseMode::READ),
+                       ::testing::Values(1, 2, 4, 8)));
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "pool_open.h"
+#include "perf/perf_utils.h"
+#include "perf/pool_location.h"
+
+void PmemobjPoolOpenPerfTest::TearDown() {
+  for (auto pop : pools_) {
+    if (pop != nullptr) {
+      pmemobj_close(pop);
+    }
+  }
+  for (const auto &path : pool_paths_) {
+    ApiC::RemoveFile(path);
+  }
+}
+
+int PmemobjPoolOpenPerfTest::CreatePools(size_t nof_pools,
+                                         size_t &nof_locations) {
+  std::vector<PoolLocation> locations;
+  for (const auto &location :
+       perf_utils::GetPoolLocations(*local_config, pool_name_)) {
+    if (perf_utils::HasFreeSpace(location.dir, nof_pools * PMEMOBJ_MIN_POOL)) {
+      locations.push_back(location);
+    }
+  }
+  nof_locations = locations.size();
+  if (locations.empty()) {
+    return 0;
+  }
+
+  for (size_t i = 0; i < nof_pools; ++i) {
+    std::string path =
+        locations[i % locations.size()].pool_path + std::to_string(i);
+    ApiC::RemoveFile(path);
+    PMEMobjpool *pop = pmemobj_create(path.c_str(), layout_.c_str(),
+                                      PMEMOBJ_MIN_POOL, S_IWRITE | S_IREAD);
+    if (pop == nullptr) {
+      std::cerr << "Pool creation failed: " << pmemobj_errormsg()
+                << std::endl;
+      return -1;
+    }
+    pool_paths_.push_back(path);
+    pmemobj_close(pop);
+  }
+  pools_.assign(nof_pools, nullptr);
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_POOL_OPEN_PERF_H
+#define PMDK_TESTS_POOL_OPEN_PERF_H
+
+#include <libpmemobj.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+#include "perf/stopwatch.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjPoolOpenPerfTest : public ::testing::Test {
+ protected:
+  std::vector<PMEMobjpool *> pools_;
+  std::vector<std::string> pool_paths_;
+  const std::string layout_ = "pool_open_perf";
+  const std::string pool_name_ = "pmdk_tests_perf_pool_open";
+
+ public:
+  void TearDown() override;
+
+  /*
+   * CreatePools -- creates nof_pools pools of minimal size, distributed
+   * round-robin among test directory and NVDIMM mountpoints with enough free
+   * space, and closes them. Number of used locations is assigned to
+   * nof_locations, no pools are created if it is 0. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int CreatePools(size_t nof_pools, size_t &nof_locations);
+
+  /*
+   * RunParallel -- calls op for indexes of all pools using nof_threads
+   * threads, each thread taking next index until all pools are processed.
+   * Collects latency of each call in stats. Returns total execution time in
+   * nanoseconds.
+   */
+  template <typename Op>
+  uint64_t RunParallel(size_t nof_threads, Op op, LatencyStats &stats);
+};
+
+class PmemobjPoolOpenPerfParamTest
+    : public PmemobjPoolOpenPerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
+
+template <typename Op>
+uint64_t PmemobjPoolOpenPerfTest::RunParallel(size_t nof_threads, Op op,
+                                              LatencyStats &stats) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<int>> future_rets;
+  std::vector<LatencyStats> thread_stats(nof_threads);
+  std::atomic<size_t> next_index{0};
+
+  for (size_t i = 0; i < nof_threads; ++i) {
+    future_rets.push_back(std::async(std::launch::async, [&, i, started]() {
+      started.wait();
+      for (size_t index = next_index++; index < pool_paths_.size();
+           index = next_index++) {
+        Stopwatch stopwatch;
+        if (op(index) != 0) {
+          return -1;
+        }
+        thread_stats[i].Add(stopwatch.ElapsedNs());
+      }
+      return 0;
+    }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &future_ret : future_rets) {
+    EXPECT_EQ(0, future_ret.get()) << pmemobj_errormsg();
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  for (auto &s : thread_stats) {
+    stats.Merge(s);
+  }
+  return elapsed;
+}
+
+#endif  // PMDK_TESTS_POOL_OPEN_PERF_H
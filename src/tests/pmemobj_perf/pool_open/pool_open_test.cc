@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "perf/perf_report.h"
+#include "pool_open.h"
+
+/**
+ * POOL_OPEN_CLOSE_CONCURRENT
+ * Parameterized Test Case: Measures opening and closing given number of pools
+ * (k) in parallel by given number of threads (n). Pools are distributed among
+ * test directory and NVDIMM mountpoints from the configuration file.
+ * \test
+ *          \li \c Step1. Create k pools of minimal size and close them
+ *          / SUCCESS
+ *          \li \c Step2. Open all pools with pmemobj_open using n threads,
+ *          each thread opening the next not yet opened pool, measuring
+ *          latency of each open and total time until all pools are open
+ *          / SUCCESS
+ *          \li \c Step3. Verify that all pools are open
+ *          \li \c Step4. Close all pools with pmemobj_close using n threads
+ *          the same way, measuring latency of each close / SUCCESS
+ *          \li \c Step5. Report time until all pools are open, latency of
+ *          opens and closes and their parallelism (sum of latencies divided
+ *          by total time), which equals 1 if opens or closes are serialised
+ *          inside libpmemobj
+ */
+TEST_P(PmemobjPoolOpenPerfParamTest, POOL_OPEN_CLOSE_CONCURRENT) {
+  const size_t nof_pools = std::get<0>(GetParam());
+  const size_t nof_threads = std::get<1>(GetParam());
+  LatencyStats open_stats;
+  LatencyStats close_stats;
+
+  /* Step 1 */
+  size_t nof_locations = 0;
+  ASSERT_EQ(0, CreatePools(nof_pools, nof_locations));
+  if (nof_locations == 0) {
+    return;
+  }
+
+  /* Step 2 */
+  uint64_t open_elapsed = RunParallel(
+      nof_threads,
+      [this](size_t i) {
+        pools_[i] = pmemobj_open(pool_paths_[i].c_str(), layout_.c_str());
+        return pools_[i] == nullptr ? -1 : 0;
+      },
+      open_stats);
+
+  /* Step 3 */
+  for (auto pop : pools_) {
+    ASSERT_TRUE(pop != nullptr);
+  }
+
+  /* Step 4 */
+  uint64_t close_elapsed = RunParallel(nof_threads,
+                                       [this](size_t i) {
+                                         pmemobj_close(pools_[i]);
+                                         pools_[i] = nullptr;
+                                         return 0;
+                                       },
+                                       close_stats);
+
+  /* Step 5 */
+  perf_report::Record("pools", nof_pools);
+  perf_report::Record("threads", nof_threads);
+  perf_report::Record("locations", nof_locations);
+  perf_report::Record("time_to_all_open", open_elapsed, "ns");
+  perf_report::RecordLatency("open", open_stats);
+  perf_report::Record("open_parallelism",
+                      open_stats.GetSum() / static_cast<double>(open_elapsed));
+  perf_report::Record("time_to_all_closed", close_elapsed, "ns");
+  perf_report::RecordLatency("close", close_stats);
+  perf_report::Record(
+      "close_parallelism",
+      close_stats.GetSum() / static_cast<double>(close_elapsed));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    PoolOpen, PmemobjPoolOpenPerfParamTest,
+    ::testing::Combine(::testing::Values(16, 64, 256),
+                       ::testing::Values(1, 4, 16)));
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "persistent_queue.h"
+
+int PersistentQueue::Init() {
+  if (!TOID_IS_NULL(root_->head)) {
+    return 0;
+  }
+
+  pobj_action actions[5];
+  TOID(struct queue_node) dummy =
+      POBJ_RESERVE_NEW(pop_, struct queue_node, &actions[0]);
+  if (TOID_IS_NULL(dummy)) {
+    return -1;
+  }
+  D_RW(dummy)->next.oid.pool_uuid_lo = dummy.oid.pool_uuid_lo;
+  D_RW(dummy)->next.oid.off = 0;
+  D_RW(dummy)->value = 0;
+  D_RW(dummy)->timestamp = 0;
+  pmemobj_persist(pop_, D_RW(dummy), sizeof(struct queue_node));
+
+  pmemobj_set_value(pop_, &actions[1], &root_->head.oid.pool_uuid_lo,
+                    dummy.oid.pool_uuid_lo);
+  pmemobj_set_value(pop_, &actions[2], &root_->head.oid.off, dummy.oid.off);
+  pmemobj_set_value(pop_, &actions[3], &root_->tail.oid.pool_uuid_lo,
+                    dummy.oid.pool_uuid_lo);
+  pmemobj_set_value(pop_, &actions[4], &root_->tail.oid.off, dummy.oid.off);
+  if (pmemobj_publish(pop_, actions, 5) != 0) {
+    pmemobj_cancel(pop_, actions, 5);
+    return -1;
+  }
+  return 0;
+}
+
+int PersistentQueue::Enqueue(uint64_t value, uint64_t timestamp) {
+  pobj_action actions[3];
+
+  TOID(struct queue_node) node =
+      POBJ_RESERVE_NEW(pop_, struct queue_node, &actions[0]);
+  if (TOID_IS_NULL(node)) {
+    return -1;
+  }
+  D_RW(node)->next.oid.pool_uuid_lo = node.oid.pool_uuid_lo;
+  D_RW(node)->next.oid.off = 0;
+  D_RW(node)->value = value;
+  D_RW(node)->timestamp = timestamp;
+  pmemobj_persist(pop_, D_RW(node), sizeof(struct queue_node));
+
+  pmemobj_mutex_lock(pop_, &root_->tail_lock);
+  pmemobj_set_value(pop_, &actions[1], &D_RW(root_->tail)->next.oid.off,
+                    node.oid.off);
+  pmemobj_set_value(pop_, &actions[2], &root_->tail.oid.off, node.oid.off);
+  int ret = pmemobj_publish(pop_, actions, 3);
+  if (ret != 0) {
+    pmemobj_cancel(pop_, actions, 3);
+  }
+  pmemobj_mutex_unlock(pop_, &root_->tail_lock);
+
+  return ret;
+}
+
+int PersistentQueue::Dequeue(uint64_t &value, uint64_t &timestamp) {
+  pobj_action actions[2];
+
+  pmemobj_mutex_lock(pop_, &root_->head_lock);
+  TOID(struct queue_node) dummy = root_->head;
+  TOID(struct queue_node) first = D_RO(dummy)->next;
+  if (TOID_IS_NULL(first)) {
+    pmemobj_mutex_unlock(pop_, &root_->head_lock);
+    return 1;
+  }
+
+  value = D_RO(first)->value;
+  timestamp = D_RO(first)->timestamp;
+  pmemobj_set_value(pop_, &actions[0], &root_->head.oid.off, first.oid.off);
+  pmemobj_defer_free(pop_, dummy.oid, &actions[1]);
+  int ret = pmemobj_publish(pop_, actions, 2);
+  if (ret != 0) {
+    pmemobj_cancel(pop_, actions, 2);
+  }
+  pmemobj_mutex_unlock(pop_, &root_->head_lock);
+
+  return ret;
+}
+
+size_t PersistentQueue::Count() const {
+  size_t count = 0;
+  TOID(struct queue_node) node = D_RO(root_->head)->next;
+  while (!TOID_IS_NULL(node)) {
+    count++;
+    node = D_RO(node)->next;
+  }
+  return count;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_PERSISTENT_QUEUE_H
+#define PMDK_TESTS_PERSISTENT_QUEUE_H
+
+#include <libpmemobj.h>
+
+struct queue_node;
+TOID_DECLARE(struct queue_node, 1);
+
+struct queue_node {
+  TOID(struct queue_node) next;
+  uint64_t value;
+  uint64_t timestamp;
+};
+
+/*
+ * queue_root -- persistent part of the queue. Head points to a dummy node,
+ * the first element of the queue is the node following it. Tail points to
+ * the last node.
+ */
+struct queue_root {
+  TOID(struct queue_node) head;
+  TOID(struct queue_node) tail;
+  PMEMmutex head_lock;
+  PMEMmutex tail_lock;
+};
+
+/*
+ * PersistentQueue -- FIFO queue built on reserve/publish API with separate
+ * locks for producers and consumers. Producers reserve and fill a node
+ * without locking and publish it together with pmemobj_set_value actions
+ * linking it after the tail and moving the tail. Consumers publish
+ * pmemobj_set_value action moving the head together with pmemobj_defer_free
+ * action releasing the previous dummy node. Each operation is therefore
+ * failure atomic and the queue is consistent after pool reopen.
+ */
+class PersistentQueue final {
+ private:
+  PMEMobjpool *pop_;
+  queue_root *root_;
+
+ public:
+  PersistentQueue(PMEMobjpool *pop, queue_root *root)
+      : pop_(pop), root_(root) {
+  }
+
+  /*
+   * Init -- allocates the dummy node if the queue was not initialized yet.
+   * Returns 0 on success, -1 otherwise.
+   */
+  int Init();
+
+  /*
+   * Enqueue -- appends element with given value and timestamp to the queue.
+   * Returns 0 on success, -1 otherwise.
+   */
+  int Enqueue(uint64_t value, uint64_t timestamp);
+
+  /*
+   * Dequeue -- removes the first element of the queue and assigns its value
+   * and timestamp to given variables. Returns 0 on success, 1 if the queue
+   * is empty and -1 on error.
+   */
+  int Dequeue(uint64_t &value, uint64_t &timestamp);
+
+  /*
+   * Count -- returns number of elements in the queue. Not thread-safe.
+   */
+  size_t Count() const;
+};
+
+#endif  // PMDK_TESTS_PERSISTENT_QUEUE_H
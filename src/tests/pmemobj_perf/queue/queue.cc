@@ -0,0 +1,131 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "queue.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+void PmemobjQueuePerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(queue_root));
+  ASSERT_FALSE(OID_IS_NULL(root_oid)) << pmemobj_errormsg();
+  root = static_cast<queue_root *>(pmemobj_direct(root_oid));
+}
+
+void PmemobjQueuePerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjQueuePerfTest::OpenPool() {
+  pmemobj_close(pop);
+  pop = pmemobj_open(pool_path_.c_str(), layout_.c_str());
+  if (pop == nullptr) {
+    std::cerr << "Pool open failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(queue_root));
+  if (OID_IS_NULL(root_oid)) {
+    std::cerr << "Root object retrieval failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+  root = static_cast<queue_root *>(pmemobj_direct(root_oid));
+
+  return 0;
+}
+
+uint64_t PmemobjQueuePerfTest::GetTimestamp() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int PmemobjQueuePerfTest::RunProducer(PersistentQueue &queue,
+                                      size_t producer_id,
+                                      std::atomic<bool> &aborted) {
+  for (size_t i = 0; i < items_per_producer && !aborted; ++i) {
+    if (queue.Enqueue(MakeValue(producer_id, i), GetTimestamp()) != 0) {
+      aborted = true;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int PmemobjQueuePerfTest::RunConsumer(PersistentQueue &queue,
+                                      size_t nof_producers, size_t nof_items,
+                                      std::atomic<size_t> &consumed,
+                                      std::atomic<bool> &aborted,
+                                      LatencyStats &stats) {
+  std::vector<int64_t> last_seq(nof_producers, -1);
+  uint64_t value = 0;
+  uint64_t timestamp = 0;
+
+  while (consumed.load() < nof_items) {
+    if (aborted) {
+      return -1;
+    }
+
+    int ret = queue.Dequeue(value, timestamp);
+    if (ret == 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (ret != 0) {
+      aborted = true;
+      return -1;
+    }
+    stats.Add(GetTimestamp() - timestamp);
+    consumed++;
+
+    size_t producer_id = value >> 32;
+    int64_t seq = value & 0xFFFFFFFF;
+    if (producer_id >= nof_producers || seq <= last_seq[producer_id]) {
+      std::cerr << "Item " << seq << " of producer " << producer_id
+                << " received out of order" << std::endl;
+      aborted = true;
+      return -1;
+    }
+    last_seq[producer_id] = seq;
+  }
+
+  return 0;
+}
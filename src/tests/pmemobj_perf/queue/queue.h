@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_QUEUE_PERF_H
+#define PMDK_TESTS_QUEUE_PERF_H
+
+#include <libpmemobj.h>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+#include "persistent_queue.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjQueuePerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  queue_root *root = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "queue_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  const size_t items_per_producer = 100000;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * OpenPool -- closes and reopens the pool. Returns 0 on success, prints
+   * error message and returns -1 otherwise.
+   */
+  int OpenPool();
+
+  /*
+   * GetTimestamp -- returns current time of steady clock in nanoseconds.
+   */
+  static uint64_t GetTimestamp();
+
+  static uint64_t MakeValue(size_t producer_id, size_t seq) {
+    return (static_cast<uint64_t>(producer_id) << 32) | seq;
+  }
+
+  /*
+   * RunProducer -- enqueues items_per_producer items with consecutive values
+   * of given producer, stopping early when aborted is set. Returns 0 on
+   * success, sets aborted and returns -1 otherwise.
+   */
+  int RunProducer(PersistentQueue &queue, size_t producer_id,
+                  std::atomic<bool> &aborted);
+
+  /*
+   * RunConsumer -- dequeues items until consumed counter reaches
+   * nof_items, collecting end-to-end latency of each item in stats and
+   * checking that items of each producer are received in order. Returns 0 on
+   * success, sets aborted and returns -1 otherwise. Returns -1 also when
+   * aborted was set by another thread.
+   */
+  int RunConsumer(PersistentQueue &queue, size_t nof_producers,
+                  size_t nof_items, std::atomic<size_t> &consumed,
+                  std::atomic<bool> &aborted, LatencyStats &stats);
+};
+
+class PmemobjQueuePerfParamTest
+    : public PmemobjQueuePerfTest,
+      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
+
+#endif  // PMDK_TESTS_QUEUE_PERF_H
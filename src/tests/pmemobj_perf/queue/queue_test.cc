@@ -0,0 +1,160 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <future>
+#include <vector>
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+#include "queue.h"
+
+/**
+ * QUEUE_MPMC
+ * Parameterized Test Case: Measures throughput and end-to-end latency of
+ * persistent FIFO queue built on reserve/publish API with given number of
+ * producers (p) and consumers (c)
+ * \test
+ *          \li \c Step1. Initialize the queue / SUCCESS
+ *          \li \c Step2. Start p producers, each enqueuing 100000 items, and c
+ *          consumers dequeuing items until all of them are consumed
+ *          / SUCCESS
+ *          \li \c Step3. Verify that items of each producer were dequeued in
+ *          order and the queue is empty
+ *          \li \c Step4. Report throughput and end-to-end latency (from
+ *          enqueue start to dequeue)
+ */
+TEST_P(PmemobjQueuePerfParamTest, QUEUE_MPMC) {
+  const size_t nof_producers = std::get<0>(GetParam());
+  const size_t nof_consumers = std::get<1>(GetParam());
+  const size_t nof_items = nof_producers * items_per_producer;
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<int>> future_rets;
+  std::vector<LatencyStats> consumer_stats(nof_consumers);
+  std::atomic<size_t> consumed{0};
+  std::atomic<bool> aborted{false};
+
+  /* Step 1 */
+  PersistentQueue queue(pop, root);
+  ASSERT_EQ(0, queue.Init()) << pmemobj_errormsg();
+
+  /* Step 2 */
+  for (size_t i = 0; i < nof_producers; ++i) {
+    future_rets.push_back(std::async(std::launch::async, [&, i, started]() {
+      started.wait();
+      return RunProducer(queue, i, aborted);
+    }));
+  }
+  for (size_t i = 0; i < nof_consumers; ++i) {
+    future_rets.push_back(std::async(std::launch::async, [&, i, started]() {
+      started.wait();
+      return RunConsumer(queue, nof_producers, nof_items, consumed, aborted,
+                         consumer_stats[i]);
+    }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &future_ret : future_rets) {
+    EXPECT_EQ(0, future_ret.get()) << pmemobj_errormsg();
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  /* Step 3 */
+  ASSERT_FALSE(HasFailure());
+  ASSERT_EQ(nof_items, consumed.load());
+  ASSERT_EQ(0, queue.Count());
+
+  /* Step 4 */
+  LatencyStats stats;
+  for (auto &s : consumer_stats) {
+    stats.Merge(s);
+  }
+  perf_report::Record("producers", nof_producers);
+  perf_report::Record("consumers", nof_consumers);
+  perf_report::Record("throughput", perf_report::OpsPerSec(nof_items, elapsed),
+                      "items/s");
+  perf_report::RecordLatency("end_to_end", stats);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Queue, PmemobjQueuePerfParamTest,
+    ::testing::Combine(::testing::Values(1, 2, 4), ::testing::Values(1, 2, 4)));
+
+/**
+ * QUEUE_REOPEN
+ * Test Case: Measures enqueue throughput and dequeue throughput of persistent
+ * FIFO queue after pool reopen
+ * \test
+ *          \li \c Step1. Initialize the queue / SUCCESS
+ *          \li \c Step2. Enqueue 100000 items / SUCCESS
+ *          \li \c Step3. Close and reopen the pool / SUCCESS
+ *          \li \c Step4. Verify number of items in the queue
+ *          \li \c Step5. Dequeue all items verifying their order / SUCCESS
+ *          \li \c Step6. Report enqueue and dequeue throughput
+ */
+TEST_F(PmemobjQueuePerfTest, QUEUE_REOPEN) {
+  /* Step 1 */
+  PersistentQueue queue(pop, root);
+  ASSERT_EQ(0, queue.Init()) << pmemobj_errormsg();
+
+  /* Step 2 */
+  std::atomic<bool> aborted{false};
+  Stopwatch stopwatch;
+  ASSERT_EQ(0, RunProducer(queue, 0, aborted)) << pmemobj_errormsg();
+  uint64_t enqueue_elapsed = stopwatch.ElapsedNs();
+
+  /* Step 3 */
+  ASSERT_EQ(0, OpenPool());
+  PersistentQueue reopened(pop, root);
+  ASSERT_EQ(0, reopened.Init()) << pmemobj_errormsg();
+
+  /* Step 4 */
+  ASSERT_EQ(items_per_producer, reopened.Count());
+
+  /* Step 5 */
+  std::atomic<size_t> consumed{0};
+  LatencyStats stats;
+  stopwatch.Restart();
+  ASSERT_EQ(0, RunConsumer(reopened, 1, items_per_producer, consumed, aborted,
+                           stats))
+      << pmemobj_errormsg();
+  uint64_t dequeue_elapsed = stopwatch.ElapsedNs();
+
+  /* Step 6 */
+  perf_report::Record(
+      "enqueue_throughput",
+      perf_report::OpsPerSec(items_per_producer, enqueue_elapsed), "items/s");
+  perf_report::Record(
+      "dequeue_throughput",
+      perf_report::OpsPerSec(items_per_producer, dequeue_elapsed), "items/s");
+}
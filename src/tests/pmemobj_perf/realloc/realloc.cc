@@ -0,0 +1,145 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "realloc.h"
+#include <random>
+
+void PmemobjReallocPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjReallocPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+std::vector<size_t> PmemobjReallocPerfTest::GetSizes(GrowthPattern pattern,
+                                                     unsigned seed) const {
+  std::vector<size_t> sizes{initial_size};
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<size_t> increment(1, max_random_increment);
+
+  switch (pattern) {
+    case GrowthPattern::DOUBLING:
+      while (sizes.back() < max_doubling_size) {
+        sizes.push_back(sizes.back() * 2);
+      }
+      break;
+    case GrowthPattern::FIXED_INCREMENT:
+      while (sizes.back() + fixed_increment <= max_increment_size) {
+        sizes.push_back(sizes.back() + fixed_increment);
+      }
+      break;
+    case GrowthPattern::RANDOM:
+      while (sizes.back() < max_increment_size) {
+        sizes.push_back(sizes.back() + increment(generator));
+      }
+      break;
+  }
+
+  return sizes;
+}
+
+int PmemobjReallocPerfTest::Grow(ReallocMethod method, PMEMoid &oid,
+                                 size_t old_size, size_t new_size) {
+  switch (method) {
+    case ReallocMethod::REALLOC:
+      return pmemobj_realloc(pop, &oid, new_size, 0);
+    case ReallocMethod::ZREALLOC:
+      return pmemobj_zrealloc(pop, &oid, new_size, 0);
+    case ReallocMethod::TX_REALLOC: {
+      int ret = 0;
+      TX_BEGIN(pop) {
+        oid = pmemobj_tx_realloc(oid, new_size, 0);
+      }
+      TX_ONABORT {
+        ret = -1;
+      }
+      TX_END
+      return ret;
+    }
+    case ReallocMethod::MANUAL: {
+      PMEMoid new_oid = OID_NULL;
+      if (pmemobj_alloc(pop, &new_oid, new_size, 0, nullptr, nullptr) != 0) {
+        return -1;
+      }
+      pmemobj_memcpy_persist(pop, pmemobj_direct(new_oid),
+                             pmemobj_direct(oid), old_size);
+      pmemobj_free(&oid);
+      oid = new_oid;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+bool PmemobjReallocPerfTest::IsContentPreserved(PMEMoid oid) const {
+  auto data = static_cast<const unsigned char *>(pmemobj_direct(oid));
+  for (size_t i = 0; i < initial_size; ++i) {
+    if (data[i] != pattern) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string PmemobjReallocPerfTest::ToString(ReallocMethod method) const {
+  switch (method) {
+    case ReallocMethod::REALLOC:
+      return "pmemobj_realloc";
+    case ReallocMethod::ZREALLOC:
+      return "pmemobj_zrealloc";
+    case ReallocMethod::TX_REALLOC:
+      return "pmemobj_tx_realloc";
+    case ReallocMethod::MANUAL:
+      return "alloc_copy_free";
+  }
+  return "";
+}
+
+std::string PmemobjReallocPerfTest::ToString(GrowthPattern pattern) const {
+  switch (pattern) {
+    case GrowthPattern::DOUBLING:
+      return "doubling";
+    case GrowthPattern::FIXED_INCREMENT:
+      return "fixed_increment";
+    case GrowthPattern::RANDOM:
+      return "random";
+  }
+  return "";
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_REALLOC_PERF_H
+#define PMDK_TESTS_REALLOC_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+enum class ReallocMethod { REALLOC, ZREALLOC, TX_REALLOC, MANUAL };
+
+enum class GrowthPattern { DOUBLING, FIXED_INCREMENT, RANDOM };
+
+class PmemobjReallocPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "realloc_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  const size_t initial_size = 64;
+  const size_t max_doubling_size = MEBIBYTE;
+  const size_t max_increment_size = 64 * KIBIBYTE;
+  const size_t fixed_increment = KIBIBYTE;
+  const size_t max_random_increment = 4 * KIBIBYTE;
+  const size_t nof_objects = 100;
+  const unsigned char pattern = 0xAB;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * GetSizes -- returns consecutive sizes of an object growing from
+   * initial_size according to given pattern. Object growing randomly uses
+   * different sequence of sizes for each seed.
+   */
+  std::vector<size_t> GetSizes(GrowthPattern pattern, unsigned seed) const;
+
+  /*
+   * Grow -- grows object from old_size to new_size with given method. MANUAL
+   * method allocates new object, copies the content and frees the old object.
+   * Returns 0 on success, -1 otherwise.
+   */
+  int Grow(ReallocMethod method, PMEMoid &oid, size_t old_size,
+           size_t new_size);
+
+  /*
+   * IsContentPreserved -- checks that first initial_size bytes of the object
+   * are equal to pattern.
+   */
+  bool IsContentPreserved(PMEMoid oid) const;
+
+  std::string ToString(ReallocMethod method) const;
+  std::string ToString(GrowthPattern pattern) const;
+};
+
+class PmemobjReallocPerfParamTest
+    : public PmemobjReallocPerfTest,
+      public ::testing::WithParamInterface<
+          std::tuple<ReallocMethod, GrowthPattern>> {};
+
+#endif  // PMDK_TESTS_REALLOC_PERF_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "perf/latency_stats.h"
+#include "perf/perf_report.h"
+#include "perf/stopwatch.h"
+#include "realloc.h"
+
+/**
+ * REALLOC_GROWTH
+ * Parameterized Test Case: Measures cost of growing objects step by step.
+ * Parameters are:
+ *  - the method used to grow an object (m): pmemobj_realloc,
+ *  pmemobj_zrealloc, pmemobj_tx_realloc or allocating new object, copying the
+ *  content and freeing the old object
+ *  - the growth pattern (p): doubling from 64 B to 1 MiB, 1 KiB increments
+ *  from 64 B to 64 KiB or random increments up to 4 KiB until 64 KiB
+ * \test
+ *          \li \c Step1. Allocate 64 B object and fill it with a pattern
+ *          / SUCCESS
+ *          \li \c Step2. Grow the object through all sizes of p with m,
+ *          measuring latency of each step and checking whether the object
+ *          was moved / SUCCESS
+ *          \li \c Step3. Verify that the pattern was preserved and free the
+ *          object
+ *          \li \c Step4. Repeat steps 1-3 for 100 objects
+ *          \li \c Step5. Report latency, number of moved and extended in
+ *          place objects and number of bytes copied
+ */
+TEST_P(PmemobjReallocPerfParamTest, REALLOC_GROWTH) {
+  const ReallocMethod method = std::get<0>(GetParam());
+  const GrowthPattern growth = std::get<1>(GetParam());
+  LatencyStats stats;
+  size_t nof_moved = 0;
+  size_t nof_in_place = 0;
+  size_t bytes_copied = 0;
+
+  /* Step 4 */
+  for (unsigned i = 0; i < nof_objects; ++i) {
+    std::vector<size_t> sizes = GetSizes(growth, i);
+
+    /* Step 1 */
+    PMEMoid oid = OID_NULL;
+    ASSERT_EQ(0, pmemobj_alloc(pop, &oid, initial_size, 0, nullptr, nullptr))
+        << pmemobj_errormsg();
+    pmemobj_memset_persist(pop, pmemobj_direct(oid), pattern, initial_size);
+
+    /* Step 2 */
+    for (size_t step = 1; step < sizes.size(); ++step) {
+      uint64_t old_off = oid.off;
+      Stopwatch stopwatch;
+      ASSERT_EQ(0, Grow(method, oid, sizes[step - 1], sizes[step]))
+          << pmemobj_errormsg();
+      stats.Add(stopwatch.ElapsedNs());
+
+      if (oid.off != old_off) {
+        nof_moved++;
+        bytes_copied += sizes[step - 1];
+      } else {
+        nof_in_place++;
+      }
+    }
+
+    /* Step 3 */
+    ASSERT_TRUE(IsContentPreserved(oid));
+    pmemobj_free(&oid);
+  }
+
+  /* Step 5 */
+  perf_report::Record("method", ToString(method));
+  perf_report::Record("pattern", ToString(growth));
+  perf_report::RecordLatency("grow", stats);
+  perf_report::Record("moved", nof_moved);
+  perf_report::Record("extended_in_place", nof_in_place);
+  perf_report::Record("bytes_copied", bytes_copied, "B");
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Realloc, PmemobjReallocPerfParamTest,
+    ::testing::Combine(::testing::Values(ReallocMethod::REALLOC,
+                                         ReallocMethod::ZREALLOC,
+                                         ReallocMethod::TX_REALLOC,
+                                         ReallocMethod::MANUAL),
+                       ::testing::Values(GrowthPattern::DOUBLING,
+                                         GrowthPattern::FIXED_INCREMENT,
+                                         GrowthPattern::RANDOM)));
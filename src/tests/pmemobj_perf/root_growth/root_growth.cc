@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "root_growth.h"
+#include <vector>
+
+void PmemobjRootGrowthPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+}
+
+void PmemobjRootGrowthPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+void PmemobjRootGrowthPerfTest::FillRoot(char *root, size_t begin,
+                                         size_t end) {
+  std::vector<char> pattern(end - begin);
+  for (size_t i = begin; i < end; ++i) {
+    pattern[i - begin] = GetPattern(i);
+  }
+  pmemobj_memcpy_persist(pop, root + begin, pattern.data(), pattern.size());
+}
+
+bool PmemobjRootGrowthPerfTest::VerifyRoot(const char *root,
+                                           size_t size) const {
+  for (size_t i = 0; i < size; ++i) {
+    if (root[i] != GetPattern(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int PmemobjRootGrowthPerfTest::ReopenPool() {
+  pmemobj_close(pop);
+  pop = nullptr;
+
+  if (pmemobj_check(pool_path_.c_str(), layout_.c_str()) != 1) {
+    std::cerr << "Pool consistency check failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+
+  pop = pmemobj_open(pool_path_.c_str(), layout_.c_str());
+  if (pop == nullptr) {
+    std::cerr << "Pool open failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_ROOT_GROWTH_PERF_H
+#define PMDK_TESTS_ROOT_GROWTH_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+class PmemobjRootGrowthPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "root_growth_perf";
+  const size_t pool_size = 1024 * MEBIBYTE;
+  const size_t min_root_size = 64;
+  const size_t max_root_size = 256 * MEBIBYTE;
+  const size_t growth_factor = 4;
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  /*
+   * GetPattern -- returns value of the byte at given offset of the root
+   * object.
+   */
+  static char GetPattern(size_t offset) {
+    return static_cast<char>((offset / 64) * 31 + offset);
+  }
+
+  /*
+   * FillRoot -- writes pattern to bytes from begin to end of the root object
+   * and persists them.
+   */
+  void FillRoot(char *root, size_t begin, size_t end);
+
+  /*
+   * VerifyRoot -- checks that first size bytes of the root object contain
+   * the pattern.
+   */
+  bool VerifyRoot(const char *root, size_t size) const;
+
+  /*
+   * ReopenPool -- closes the pool, checks its consistency with pmemobj_check
+   * and opens it again. Returns 0 on success, prints error message and
+   * returns -1 otherwise.
+   */
+  int ReopenPool();
+};
+
+#endif  // PMDK_TESTS_ROOT_GROWTH_PERF_H
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "perf/stopwatch.h"
+#include "root_growth.h"
+
+/**
+ * ROOT_GROWTH
+ * Test Case: Measures latency of growing the root object with pmemobj_root
+ * from 64 B to 256 MiB, multiplying its size by 4 in each step
+ * \test
+ *          \li \c Step1. Create 1 GiB pool / SUCCESS
+ *          \li \c Step2. Grow the root object to the next size with
+ *          pmemobj_root measuring latency and checking whether the root
+ *          object was relocated / SUCCESS
+ *          \li \c Step3. Verify that previous content of the root object is
+ *          preserved and fill the new part with a pattern
+ *          \li \c Step4. Close the pool, check it with pmemobj_check and
+ *          reopen it / SUCCESS
+ *          \li \c Step5. Verify size and content of the root object
+ *          \li \c Step6. Report growth latency, relocation and number of
+ *          copied bytes for the step
+ *          \li \c Step7. Repeat steps 2-6 for all sizes
+ */
+TEST_F(PmemobjRootGrowthPerfTest, ROOT_GROWTH) {
+  size_t size = 0;
+  size_t total_copied = 0;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  PMEMoid root_oid = OID_NULL;
+
+  /* Step 7 */
+  for (size_t new_size = min_root_size; new_size <= max_root_size;
+       new_size *= growth_factor) {
+    /* Step 2 */
+    Stopwatch stopwatch;
+    PMEMoid new_root_oid = pmemobj_root(pop, new_size);
+    uint64_t elapsed = stopwatch.ElapsedNs();
+    ASSERT_FALSE(OID_IS_NULL(new_root_oid)) << pmemobj_errormsg();
+    bool relocated = size > 0 && new_root_oid.off != root_oid.off;
+    size_t copied = relocated ? size : 0;
+    total_copied += copied;
+
+    /* Step 3 */
+    auto root = static_cast<char *>(pmemobj_direct(new_root_oid));
+    ASSERT_TRUE(VerifyRoot(root, size));
+    FillRoot(root, size, new_size);
+    size = new_size;
+
+    /* Step 4 */
+    ASSERT_EQ(0, ReopenPool());
+
+    /* Step 5 */
+    root_oid = pmemobj_root(pop, size);
+    ASSERT_FALSE(OID_IS_NULL(root_oid)) << pmemobj_errormsg();
+    ASSERT_LE(size, pmemobj_root_size(pop));
+    ASSERT_TRUE(VerifyRoot(static_cast<char *>(pmemobj_direct(root_oid)),
+                           size));
+
+    /* Step 6 */
+    const std::string prefix = "root_" + std::to_string(size);
+    perf_report::Record(prefix + "_growth", elapsed, "ns");
+    perf_report::Record(prefix + "_relocated", relocated);
+    perf_report::Record(prefix + "_copied", copied, "B");
+  }
+
+  perf_report::Record("total_copied", total_copied, "B");
+}
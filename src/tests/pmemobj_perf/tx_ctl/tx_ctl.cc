@@ -0,0 +1,220 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "tx_ctl.h"
+#include <cstring>
+#include <future>
+#include "perf/stopwatch.h"
+
+PostCommitWorkers::PostCommitWorkers(PMEMobjpool *pop, size_t nof_workers)
+    : pop_(pop) {
+  for (size_t i = 0; i < nof_workers; ++i) {
+    workers_.push_back(std::async(std::launch::async, [pop]() {
+      return pmemobj_ctl_exec(pop, "tx.post_commit.worker", nullptr);
+    }));
+  }
+}
+
+PostCommitWorkers::~PostCommitWorkers() {
+  Stop();
+}
+
+int PostCommitWorkers::Stop() {
+  if (workers_.empty()) {
+    return 0;
+  }
+
+  int ret = 0;
+  if (pmemobj_ctl_exec(pop_, "tx.post_commit.stop", nullptr) != 0) {
+    std::cerr << "Stopping post commit workers failed: " << pmemobj_errormsg()
+              << std::endl;
+    ret = -1;
+  }
+  for (auto &worker : workers_) {
+    if (worker.get() != 0) {
+      std::cerr << "Post commit worker failed: " << pmemobj_errormsg()
+                << std::endl;
+      ret = -1;
+    }
+  }
+  workers_.clear();
+
+  return ret;
+}
+
+void PmemobjTxCtlPerfTest::TearDown() {
+  ClosePool();
+}
+
+std::vector<TxCtlSettings> PmemobjTxCtlPerfTest::GetSettings() const {
+  return {TxCtlSettings("default", -1, -1, -1, 0),
+          TxCtlSettings("cache_size_0", 0, 0, -1, 0),
+          TxCtlSettings("cache_size_128KiB", 128 * KIBIBYTE, -1, -1, 0),
+          TxCtlSettings("cache_size_1MiB", MEBIBYTE, -1, -1, 0),
+          TxCtlSettings("cache_threshold_0", -1, 0, -1, 0),
+          TxCtlSettings("cache_threshold_16KiB", -1, 16 * KIBIBYTE, -1, 0),
+          TxCtlSettings("post_commit_queue_64", -1, -1, 64, 0),
+          TxCtlSettings("post_commit_queue_64_workers_1", -1, -1, 64, 1),
+          TxCtlSettings("post_commit_queue_256_workers_2", -1, -1, 256, 2)};
+}
+
+int PmemobjTxCtlPerfTest::CreatePool() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  if (pop == nullptr) {
+    std::cerr << "Pool creation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  PMEMoid root_oid = pmemobj_root(pop, sizeof(tx_ctl_root));
+  if (OID_IS_NULL(root_oid)) {
+    std::cerr << "Root allocation failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+  root = static_cast<tx_ctl_root *>(pmemobj_direct(root_oid));
+
+  return 0;
+}
+
+void PmemobjTxCtlPerfTest::ClosePool() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+    pop = nullptr;
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjTxCtlPerfTest::ApplySettings(const TxCtlSettings &settings) {
+  long long cache_size = settings.cache_size;
+  long long cache_threshold = settings.cache_threshold;
+  int queue_depth = settings.queue_depth;
+
+  if (cache_size >= 0 &&
+      pmemobj_ctl_set(pop, "tx.cache.size", &cache_size) != 0) {
+    std::cerr << "Setting tx.cache.size failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+  if (cache_threshold >= 0 &&
+      pmemobj_ctl_set(pop, "tx.cache.threshold", &cache_threshold) != 0) {
+    std::cerr << "Setting tx.cache.threshold failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+  if (queue_depth >= 0 &&
+      pmemobj_ctl_set(pop, "tx.post_commit.queue_depth", &queue_depth) != 0) {
+    std::cerr << "Setting tx.post_commit.queue_depth failed: "
+              << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int PmemobjTxCtlPerfTest::RunTransaction(size_t thread_id) {
+  int ret = 0;
+
+  TX_BEGIN(pop) {
+    pmemobj_tx_add_range_direct(&root->counters[thread_id], sizeof(uint64_t));
+    root->counters[thread_id]++;
+
+    PMEMoid oid = pmemobj_tx_alloc(object_size, 0);
+    memset(pmemobj_direct(oid), static_cast<int>(thread_id), object_size);
+    if (!OID_IS_NULL(root->objects[thread_id])) {
+      pmemobj_tx_free(root->objects[thread_id]);
+    }
+    pmemobj_tx_add_range_direct(&root->objects[thread_id], sizeof(PMEMoid));
+    root->objects[thread_id] = oid;
+  }
+  TX_ONABORT {
+    ret = -1;
+  }
+  TX_END
+
+  return ret;
+}
+
+uint64_t PmemobjTxCtlPerfTest::RunTransactions(LatencyStats &stats) {
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::future<int>> future_rets;
+  std::vector<LatencyStats> thread_stats(nof_threads);
+
+  for (size_t i = 0; i < nof_threads; ++i) {
+    future_rets.push_back(std::async(std::launch::async, [this, i, started,
+                                                          &thread_stats]() {
+      thread_stats[i].Reserve(tx_per_thread);
+      started.wait();
+      for (size_t j = 0; j < tx_per_thread; ++j) {
+        Stopwatch stopwatch;
+        if (RunTransaction(i) != 0) {
+          return -1;
+        }
+        thread_stats[i].Add(stopwatch.ElapsedNs());
+      }
+      return 0;
+    }));
+  }
+
+  Stopwatch total;
+  start.set_value();
+  for (auto &future_ret : future_rets) {
+    EXPECT_EQ(0, future_ret.get()) << pmemobj_errormsg();
+  }
+  uint64_t elapsed = total.ElapsedNs();
+
+  for (auto &s : thread_stats) {
+    stats.Merge(s);
+  }
+  return elapsed;
+}
+
+bool PmemobjTxCtlPerfTest::IsWorkerSupported() {
+  if (CreatePool() != 0) {
+    ClosePool();
+    return false;
+  }
+
+  bool supported = false;
+  int queue_depth = 64;
+  if (pmemobj_ctl_set(pop, "tx.post_commit.queue_depth", &queue_depth) == 0) {
+    /* a stopped queue makes the worker return at once, so this cannot hang */
+    PostCommitWorkers workers(pop, 1);
+    supported = workers.Stop() == 0;
+  }
+  ClosePool();
+
+  return supported;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_TX_CTL_PERF_H
+#define PMDK_TESTS_TX_CTL_PERF_H
+
+#include <libpmemobj.h>
+#include <future>
+#include <memory>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+#define TX_CTL_MAX_THREADS 64
+
+struct tx_ctl_root {
+  PMEMoid objects[TX_CTL_MAX_THREADS];
+  uint64_t counters[TX_CTL_MAX_THREADS];
+};
+
+/*
+ * TxCtlSettings -- transaction related CTL values applied to the pool before
+ * running the workload. Negative values leave library defaults unchanged.
+ */
+struct TxCtlSettings {
+  std::string name;
+  long long cache_size;
+  long long cache_threshold;
+  int queue_depth;
+  size_t nof_workers;
+
+  TxCtlSettings(const std::string &name, long long cache_size,
+                long long cache_threshold, int queue_depth,
+                size_t nof_workers)
+      : name(name),
+        cache_size(cache_size),
+        cache_threshold(cache_threshold),
+        queue_depth(queue_depth),
+        nof_workers(nof_workers) {
+  }
+};
+
+/*
+ * PostCommitWorkers -- runs tx.post_commit.worker in given number of threads
+ * for the lifetime of the object. Workers still running on destruction are
+ * stopped and joined, so that no exit path leaves them blocked.
+ */
+class PostCommitWorkers final {
+ private:
+  PMEMobjpool *pop_;
+  std::vector<std::future<int>> workers_;
+
+ public:
+  PostCommitWorkers(PMEMobjpool *pop, size_t nof_workers);
+  ~PostCommitWorkers();
+
+  /*
+   * Stop -- stops workers with tx.post_commit.stop and waits for them.
+   * Returns 0 on success, -1 if stopping or any of the workers failed.
+   */
+  int Stop();
+};
+
+class PmemobjTxCtlPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  tx_ctl_root *root = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "tx_ctl_perf";
+  const size_t pool_size = 256 * MEBIBYTE;
+  const size_t object_size = 256;
+  const size_t nof_threads = 4;
+  const size_t tx_per_thread = 10000;
+
+ public:
+  void TearDown() override;
+
+  /*
+   * GetSettings -- returns library defaults followed by variations of
+   * tx.cache.size, tx.cache.threshold and tx.post_commit settings.
+   */
+  std::vector<TxCtlSettings> GetSettings() const;
+
+  /*
+   * CreatePool -- creates pool and allocates the root object. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  int CreatePool();
+  void ClosePool();
+
+  /*
+   * ApplySettings -- sets CTL values from given settings. Returns 0 on
+   * success, prints error message and returns -1 if any of them is not
+   * supported by libpmemobj.
+   */
+  int ApplySettings(const TxCtlSettings &settings);
+
+  /*
+   * IsWorkerSupported -- checks on a temporary pool whether libpmemobj
+   * supports running and stopping tx.post_commit.worker. Must be called
+   * before CreatePool.
+   */
+  bool IsWorkerSupported();
+
+  /*
+   * RunTransactions -- runs tx_per_thread transactions in each of nof_threads
+   * threads. Each transaction increments the counter of the thread, allocates
+   * and fills a new object and frees the object allocated in previous
+   * transaction. Collects latency of all transactions in stats and returns
+   * total execution time in nanoseconds.
+   */
+  uint64_t RunTransactions(LatencyStats &stats);
+
+  /*
+   * RunTransaction -- runs a single transaction of given thread. Returns 0 on
+   * success, -1 if the transaction was aborted.
+   */
+  int RunTransaction(size_t thread_id);
+};
+
+#endif  // PMDK_TESTS_TX_CTL_PERF_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "perf/perf_report.h"
+#include "tx_ctl.h"
+
+/**
+ * TX_CTL_SWEEP
+ * Test Case: Measures throughput and latency of a transactional allocation and
+ * update workload under different values of tx.cache.size,
+ * tx.cache.threshold, tx.post_commit.queue_depth and number of
+ * tx.post_commit.worker threads
+ * \test
+ *          \li \c Step1. Check whether post commit workers are supported
+ *          and create pool / SUCCESS
+ *          \li \c Step2. Apply CTL settings with pmemobj_ctl_set, skip the
+ *          settings if they are not supported by libpmemobj or require
+ *          unsupported post commit workers
+ *          \li \c Step3. Start post commit workers with pmemobj_ctl_exec if
+ *          required by the settings, they are stopped on any exit path
+ *          \li \c Step4. Run 10000 transactions in each of 4 threads, each
+ *          incrementing a counter, allocating new object and freeing the
+ *          previous one / SUCCESS
+ *          \li \c Step5. Stop post commit workers / SUCCESS
+ *          \li \c Step6. Verify counters of all threads
+ *          \li \c Step7. Report commits per second and transaction latency,
+ *          close and remove the pool
+ *          \li \c Step8. Repeat steps 1-7 for all settings, checking
+ *          worker support only once
+ *          \li \c Step9. Report the settings with the highest throughput as
+ *          recommended
+ */
+TEST_F(PmemobjTxCtlPerfTest, TX_CTL_SWEEP) {
+  std::string recommended;
+  double max_throughput = 0;
+
+  /* Step 1 */
+  bool workers_supported = IsWorkerSupported();
+
+  /* Step 8 */
+  for (const auto &settings : GetSettings()) {
+    /* Step 1 */
+    ASSERT_EQ(0, CreatePool());
+
+    /* Step 2 */
+    if ((settings.nof_workers > 0 && !workers_supported) ||
+        ApplySettings(settings) != 0) {
+      std::cout << "Settings " << settings.name << " skipped" << std::endl;
+      ClosePool();
+      continue;
+    }
+
+    /* Step 3 */
+    PostCommitWorkers workers(pop, settings.nof_workers);
+
+    /* Step 4 */
+    LatencyStats stats;
+    uint64_t elapsed = RunTransactions(stats);
+
+    /* Step 5 */
+    ASSERT_EQ(0, workers.Stop());
+
+    /* Step 6 */
+    for (size_t i = 0; i < nof_threads; ++i) {
+      ASSERT_EQ(tx_per_thread, root->counters[i]);
+    }
+
+    /* Step 7 */
+    double throughput =
+        perf_report::OpsPerSec(nof_threads * tx_per_thread, elapsed);
+    perf_report::Record(settings.name + "_throughput", throughput,
+                        "commits/s");
+    perf_report::RecordLatency(settings.name + "_tx", stats);
+    if (throughput > max_throughput) {
+      max_throughput = throughput;
+      recommended = settings.name;
+    }
+    ClosePool();
+  }
+
+  /* Step 9 */
+  perf_report::Record("recommended", recommended);
+}
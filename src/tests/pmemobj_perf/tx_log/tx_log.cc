@@ -0,0 +1,178 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "tx_log.h"
+#include <algorithm>
+#include <cstring>
+#include "perf/stopwatch.h"
+
+void PmemobjTxLogPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+int PmemobjTxLogPerfTest::CreatePool() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  if (pop == nullptr) {
+    std::cerr << "Pool creation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  enum pobj_stats_enabled stats_enabled = POBJ_STATS_ENABLED_TRANSIENT;
+  if (pmemobj_ctl_set(pop, "stats.enabled", &stats_enabled) != 0) {
+    std::cerr << "Enabling statistics failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+
+  if (pmemobj_zalloc(pop, &data_, max_tx_size, 0) != 0) {
+    std::cerr << "Data allocation failed: " << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+size_t PmemobjTxLogPerfTest::GetNofRanges(size_t tx_size) const {
+  return (tx_size + range_size - 1) / range_size;
+}
+
+size_t PmemobjTxLogPerfTest::GetNofAllocs(size_t tx_size) const {
+  return (tx_size + bytes_per_alloc - 1) / bytes_per_alloc;
+}
+
+int PmemobjTxLogPerfTest::AllocateLogBuffers(size_t tx_size) {
+  std::vector<size_t> sizes(GetNofRanges(tx_size), range_size);
+  snapshot_buffer_size_ =
+      pmemobj_tx_log_snapshots_max_size(sizes.data(), sizes.size());
+  intent_buffer_size_ = pmemobj_tx_log_intents_max_size(GetNofAllocs(tx_size));
+
+  if (snapshot_buffer_size_ == SIZE_MAX || intent_buffer_size_ == SIZE_MAX) {
+    std::cerr << "Log buffer size calculation failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+
+  if (pmemobj_alloc(pop, &snapshot_buffer_, snapshot_buffer_size_, 0, nullptr,
+                    nullptr) != 0 ||
+      pmemobj_alloc(pop, &intent_buffer_, intent_buffer_size_, 0, nullptr,
+                    nullptr) != 0) {
+    std::cerr << "Log buffer allocation failed: " << pmemobj_errormsg()
+              << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+uint64_t PmemobjTxLogPerfTest::GetAllocatedBytes() {
+  uint64_t allocated = 0;
+  pmemobj_ctl_get(pop, "stats.heap.curr_allocated", &allocated);
+  return allocated;
+}
+
+int PmemobjTxLogPerfTest::RunTransaction(
+    LogMode mode, size_t tx_size, unsigned char value,
+    std::vector<PMEMoid> &objects, LatencyStats &tx_stats,
+    LatencyStats &commit_stats, uint64_t &log_bytes) {
+  auto data = static_cast<char *>(pmemobj_direct(data_));
+  const size_t nof_allocs = GetNofAllocs(tx_size);
+  uint64_t allocated_before = GetAllocatedBytes();
+  int ret = 0;
+
+  Stopwatch tx;
+  Stopwatch commit;
+  TX_BEGIN(pop) {
+    if (mode != LogMode::DEFAULT) {
+      pmemobj_tx_log_append_buffer(TX_LOG_TYPE_SNAPSHOT,
+                                   pmemobj_direct(snapshot_buffer_),
+                                   snapshot_buffer_size_);
+      pmemobj_tx_log_append_buffer(TX_LOG_TYPE_INTENT,
+                                   pmemobj_direct(intent_buffer_),
+                                   intent_buffer_size_);
+    }
+    if (mode == LogMode::APPEND_BUFFER_NO_AUTO_ALLOC) {
+      pmemobj_tx_log_auto_alloc(TX_LOG_TYPE_SNAPSHOT, 0);
+      pmemobj_tx_log_auto_alloc(TX_LOG_TYPE_INTENT, 0);
+    }
+
+    for (size_t offset = 0; offset < tx_size; offset += range_size) {
+      size_t size = std::min(range_size, tx_size - offset);
+      pmemobj_tx_add_range(data_, offset, size);
+      memset(data + offset, value, size);
+    }
+    for (size_t i = 0; i < nof_allocs; ++i) {
+      objects.push_back(pmemobj_tx_alloc(object_size, 0));
+    }
+
+    log_bytes = GetAllocatedBytes() - allocated_before;
+    commit.Restart();
+  }
+  TX_ONABORT {
+    ret = -1;
+  }
+  TX_END
+
+  if (ret == 0) {
+    commit_stats.Add(commit.ElapsedNs());
+    tx_stats.Add(tx.ElapsedNs());
+  }
+  return ret;
+}
+
+bool PmemobjTxLogPerfTest::VerifyData(size_t tx_size,
+                                      unsigned char value) const {
+  auto data = static_cast<const unsigned char *>(pmemobj_direct(data_));
+  for (size_t i = 0; i < tx_size; ++i) {
+    if (data[i] != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string PmemobjTxLogPerfTest::ToString(LogMode mode) const {
+  switch (mode) {
+    case LogMode::DEFAULT:
+      return "default";
+    case LogMode::APPEND_BUFFER:
+      return "append_buffer";
+    case LogMode::APPEND_BUFFER_NO_AUTO_ALLOC:
+      return "append_buffer_no_auto_alloc";
+  }
+  return "";
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_TX_LOG_PERF_H
+#define PMDK_TESTS_TX_LOG_PERF_H
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * LogMode -- source of transaction log space:
+ *  - DEFAULT - log extensions allocated by libpmemobj
+ *  - APPEND_BUFFER - pre-reserved buffers appended with
+ *  pmemobj_tx_log_append_buffer, extensions allocated when needed
+ *  - APPEND_BUFFER_NO_AUTO_ALLOC - pre-reserved buffers appended with
+ *  pmemobj_tx_log_append_buffer and automatic allocation of extensions
+ *  disabled with pmemobj_tx_log_auto_alloc
+ */
+enum class LogMode { DEFAULT, APPEND_BUFFER, APPEND_BUFFER_NO_AUTO_ALLOC };
+
+class PmemobjTxLogPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  PMEMoid data_ = OID_NULL;
+  PMEMoid snapshot_buffer_ = OID_NULL;
+  PMEMoid intent_buffer_ = OID_NULL;
+  size_t snapshot_buffer_size_ = 0;
+  size_t intent_buffer_size_ = 0;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "tx_log_perf";
+  const size_t pool_size = 1024 * MEBIBYTE;
+  const size_t max_tx_size = 256 * MEBIBYTE;
+  /* size of a single range snapshotted in the transaction */
+  const size_t range_size = 4 * KIBIBYTE;
+  /* one object is allocated in the transaction per bytes_per_alloc bytes
+   * modified */
+  const size_t bytes_per_alloc = 64 * KIBIBYTE;
+  const size_t object_size = 256;
+  /* number of bytes modified by all transactions of given size */
+  const size_t bytes_per_size = 256 * MEBIBYTE;
+  const size_t min_repeats = 3;
+
+ public:
+  void TearDown() override;
+  const std::string &GetTestDir() const {
+    return test_dir_;
+  }
+
+  /*
+   * CreatePool -- creates pool, enables heap statistics and allocates object
+   * modified by transactions. Returns 0 on success, prints error message and
+   * returns -1 otherwise.
+   */
+  int CreatePool();
+
+  size_t GetNofRanges(size_t tx_size) const;
+  size_t GetNofAllocs(size_t tx_size) const;
+
+  /*
+   * AllocateLogBuffers -- allocates snapshot and intent log buffers big
+   * enough for transaction of given size. Returns 0 on success, prints error
+   * message and returns -1 otherwise.
+   */
+  int AllocateLogBuffers(size_t tx_size);
+
+  /*
+   * RunTransaction -- snapshots and modifies tx_size bytes of data object in
+   * range_size ranges and allocates GetNofAllocs(tx_size) objects in a single
+   * transaction, using log space according to given mode. Collects latency of
+   * the whole transaction and of its commit, number of bytes allocated from
+   * the heap for log extensions during the transaction and stores allocated
+   * objects in objects vector. Returns 0 on success, -1 if the transaction
+   * was aborted.
+   */
+  int RunTransaction(LogMode mode, size_t tx_size, unsigned char value,
+                     std::vector<PMEMoid> &objects, LatencyStats &tx_stats,
+                     LatencyStats &commit_stats, uint64_t &log_bytes);
+
+  uint64_t GetAllocatedBytes();
+  bool VerifyData(size_t tx_size, unsigned char value) const;
+  std::string ToString(LogMode mode) const;
+};
+
+class PmemobjTxLogPerfParamTest
+    : public PmemobjTxLogPerfTest,
+      public ::testing::WithParamInterface<std::tuple<LogMode, size_t>> {};
+
+#endif  // PMDK_TESTS_TX_LOG_PERF_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <algorithm>
+#include "perf/perf_report.h"
+#include "perf/perf_utils.h"
+#include "tx_log.h"
+
+/**
+ * TX_LOG_BUFFERS
+ * Parameterized Test Case: Measures latency of transactions modifying and
+ * snapshotting given number of bytes (s) and allocating one 256 B object per
+ * 64 KiB modified, with transaction log space provided according to given
+ * mode (m): allocated by libpmemobj, appended with
+ * pmemobj_tx_log_append_buffer or appended with automatic allocation of log
+ * extensions disabled
+ * \test
+ *          \li \c Step1. Create 1 GiB pool and allocate 256 MiB data object
+ *          / SUCCESS
+ *          \li \c Step2. Allocate snapshot and intent log buffers big enough
+ *          for transaction of size s, if required by m / SUCCESS
+ *          \li \c Step3. Run transaction snapshotting and modifying s bytes
+ *          in 4 KiB ranges and allocating objects, measuring latency of the
+ *          transaction, latency of its commit and number of bytes allocated
+ *          for log extensions / SUCCESS
+ *          \li \c Step4. Verify modified data and free allocated objects
+ *          \li \c Step5. Repeat steps 3-4 so that at least 256 MiB (and at
+ *          least 3 transactions) are modified
+ *          \li \c Step6. Report latency of transactions and commits, bytes
+ *          allocated for log extensions and bytes still allocated for logs
+ *          after all transactions
+ */
+TEST_P(PmemobjTxLogPerfParamTest, TX_LOG_BUFFERS) {
+  const LogMode mode = std::get<0>(GetParam());
+  const size_t tx_size = std::get<1>(GetParam());
+  const size_t repeats = std::max(min_repeats, bytes_per_size / tx_size);
+  LatencyStats tx_stats;
+  LatencyStats commit_stats;
+  LatencyStats log_bytes_stats;
+
+  if (!perf_utils::HasFreeSpace(GetTestDir(), pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool());
+
+  /* Step 2 */
+  if (mode != LogMode::DEFAULT) {
+    ASSERT_EQ(0, AllocateLogBuffers(tx_size));
+  }
+  uint64_t allocated_before = GetAllocatedBytes();
+
+  /* Step 5 */
+  for (size_t i = 0; i < repeats; ++i) {
+    std::vector<PMEMoid> objects;
+    uint64_t log_bytes = 0;
+    const unsigned char value = static_cast<unsigned char>(i + 1);
+
+    /* Step 3 */
+    ASSERT_EQ(0, RunTransaction(mode, tx_size, value, objects, tx_stats,
+                                commit_stats, log_bytes))
+        << pmemobj_errormsg();
+    log_bytes_stats.Add(log_bytes);
+
+    /* Step 4 */
+    ASSERT_TRUE(VerifyData(tx_size, value));
+    for (auto &oid : objects) {
+      pmemobj_free(&oid);
+    }
+  }
+
+  /* Step 6 */
+  perf_report::Record("mode", ToString(mode));
+  perf_report::Record("tx_size", tx_size, "B");
+  perf_report::RecordLatency("tx", tx_stats);
+  perf_report::RecordLatency("commit", commit_stats);
+  perf_report::Record("log_extension_bytes_mean", log_bytes_stats.GetMean(),
+                      "B");
+  perf_report::Record("log_extension_bytes_max", log_bytes_stats.GetMax(),
+                      "B");
+  perf_report::Record(
+      "retained_log_bytes",
+      static_cast<long long>(GetAllocatedBytes() - allocated_before), "B");
+}
+
+INSTANTIATE_TEST_CASE_P(
+    TxLog, PmemobjTxLogPerfParamTest,
+    ::testing::Combine(::testing::Values(LogMode::DEFAULT,
+                                         LogMode::APPEND_BUFFER,
+                                         LogMode::APPEND_BUFFER_NO_AUTO_ALLOC),
+                       ::testing::Values(4 * KIBIBYTE, 64 * KIBIBYTE,
+                                         MEBIBYTE, 16 * MEBIBYTE,
+                                         256 * MEBIBYTE)));
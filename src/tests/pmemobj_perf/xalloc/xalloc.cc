@@ -0,0 +1,152 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "xalloc.h"
+#include <algorithm>
+#include <vector>
+#include "perf/stopwatch.h"
+
+void PmemobjXallocPerfTest::SetUp() {
+  ApiC::RemoveFile(pool_path_);
+  pop = pmemobj_create(pool_path_.c_str(), layout_.c_str(), pool_size,
+                       S_IWRITE | S_IREAD);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+}
+
+void PmemobjXallocPerfTest::TearDown() {
+  if (pop != nullptr) {
+    pmemobj_close(pop);
+  }
+  ApiC::RemoveFile(pool_path_);
+}
+
+void PmemobjXallocPerfTest::RegisterClass(size_t size) {
+  if (size > max_class_size) {
+    return;
+  }
+
+  pobj_alloc_class_desc desc;
+  desc.unit_size = size;
+  desc.alignment = 0;
+  desc.units_per_block =
+      static_cast<unsigned>(std::max(size_t{1}, 256 * KIBIBYTE / size));
+  desc.header_type = POBJ_HEADER_NONE;
+  if (pmemobj_ctl_set(pop, "heap.alloc_class.new.desc", &desc) != 0) {
+    std::cerr << "Registering allocation class failed: " << pmemobj_errormsg()
+              << std::endl;
+    return;
+  }
+  class_id_ = desc.class_id;
+  class_registered_ = true;
+}
+
+void PmemobjXallocPerfTest::CreateArena() {
+  if (pmemobj_ctl_exec(pop, "heap.arena.create", &arena_id_) != 0) {
+    std::cerr << "Creating arena failed: " << pmemobj_errormsg() << std::endl;
+    return;
+  }
+  arena_created_ = true;
+}
+
+bool PmemobjXallocPerfTest::IsSupported(unsigned index) const {
+  return (!(index & XALLOC_CLASS) || class_registered_) &&
+         (!(index & XALLOC_ARENA) || arena_created_);
+}
+
+uint64_t PmemobjXallocPerfTest::GetFlags(unsigned index) const {
+  uint64_t flags = 0;
+  if (index & XALLOC_ZERO) {
+    flags |= POBJ_XALLOC_ZERO;
+  }
+  if (index & XALLOC_NO_FLUSH) {
+    flags |= POBJ_XALLOC_NO_FLUSH;
+  }
+  if (index & XALLOC_CLASS) {
+    flags |= POBJ_CLASS_ID(class_id_);
+  }
+  if (index & XALLOC_ARENA) {
+    flags |= POBJ_ARENA_ID(arena_id_);
+  }
+  return flags;
+}
+
+std::string PmemobjXallocPerfTest::FlagsToString(unsigned index) const {
+  std::string names;
+  for (size_t i = 0; i < flag_names.size(); i++) {
+    if (index & (1u << i)) {
+      names += (names.empty() ? "" : "|") + flag_names[i];
+    }
+  }
+  return names.empty() ? "0" : names;
+}
+
+size_t PmemobjXallocPerfTest::GetNofObjects(size_t size) const {
+  return std::min(max_objects,
+                  std::max(min_objects, bytes_per_combination / size));
+}
+
+uint64_t PmemobjXallocPerfTest::MeasureXalloc(size_t size, uint64_t flags,
+                                              size_t nof_objects,
+                                              LatencyStats &stats) {
+  std::vector<PMEMoid> objects(nof_objects, OID_NULL);
+  uint64_t total = 0;
+
+  for (auto &oid : objects) {
+    Stopwatch stopwatch;
+    if (pmemobj_xalloc(pop, &oid, size, 0, flags, nullptr, nullptr) != 0) {
+      std::cerr << "Allocation failed: " << pmemobj_errormsg() << std::endl;
+      total = 0;
+      break;
+    }
+    uint64_t elapsed = stopwatch.ElapsedNs();
+    stats.Add(elapsed);
+    total += elapsed;
+  }
+
+  for (auto &oid : objects) {
+    if (OID_IS_NULL(oid)) {
+      continue;
+    }
+    if (flags & POBJ_XALLOC_ZERO) {
+      auto data = static_cast<const char *>(pmemobj_direct(oid));
+      if (std::any_of(data, data + size, [](char c) { return c != 0; })) {
+        std::cerr << "Object allocated with POBJ_XALLOC_ZERO is not zeroed"
+                  << std::endl;
+        total = 0;
+      }
+    }
+    pmemobj_free(&oid);
+  }
+
+  return total;
+}
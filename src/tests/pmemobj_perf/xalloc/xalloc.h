@@ -0,0 +1,123 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_XALLOC_PERF_H
+#define PMDK_TESTS_XALLOC_PERF_H
+
+#include <libpmemobj.h>
+#include <array>
+#include <memory>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "perf/latency_stats.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/* bits of flag combination index */
+enum XallocFlag : unsigned {
+  XALLOC_ZERO = 1 << 0,
+  XALLOC_NO_FLUSH = 1 << 1,
+  XALLOC_CLASS = 1 << 2,
+  XALLOC_ARENA = 1 << 3,
+  XALLOC_ALL = (1 << 4) - 1
+};
+
+class PmemobjXallocPerfTest : public ::testing::Test {
+ private:
+  const std::string test_dir_ = local_config->GetTestDir();
+
+ protected:
+  PMEMobjpool *pop = nullptr;
+  const std::string pool_path_ = test_dir_ + "pool";
+  const std::string layout_ = "xalloc_perf";
+  const size_t pool_size = 512 * MEBIBYTE;
+  /* largest object size for which custom allocation class is registered */
+  const size_t max_class_size = 64 * KIBIBYTE;
+  /* number of bytes allocated for each flag combination */
+  const size_t bytes_per_combination = 128 * MEBIBYTE;
+  const size_t min_objects = 64;
+  const size_t max_objects = 100000;
+  unsigned class_id_ = 0;
+  unsigned arena_id_ = 0;
+  bool class_registered_ = false;
+  bool arena_created_ = false;
+  const std::array<std::string, 4> flag_names = {
+      {"ZERO", "NO_FLUSH", "CLASS_ID", "ARENA_ID"}};
+
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+  /*
+   * RegisterClass -- registers allocation class with unit size equal to given
+   * size and no object header, so that each object occupies exactly one unit,
+   * if the size does not exceed max_class_size.
+   */
+  void RegisterClass(size_t size);
+
+  /*
+   * CreateArena -- creates new arena with heap.arena.create, if supported by
+   * libpmemobj.
+   */
+  void CreateArena();
+
+  /*
+   * IsSupported -- checks that allocation class and arena required by given
+   * flag combination are available.
+   */
+  bool IsSupported(unsigned index) const;
+
+  /*
+   * GetFlags -- converts flag combination index to pmemobj_xalloc flags.
+   */
+  uint64_t GetFlags(unsigned index) const;
+  std::string FlagsToString(unsigned index) const;
+
+  size_t GetNofObjects(size_t size) const;
+
+  /*
+   * MeasureXalloc -- allocates nof_objects objects of given size with
+   * pmemobj_xalloc and given flags, collecting latency of each allocation in
+   * stats, then verifies that objects are zeroed if POBJ_XALLOC_ZERO flag is
+   * set and frees them. Returns total allocation time in nanoseconds on
+   * success, prints error message and returns 0 otherwise.
+   */
+  uint64_t MeasureXalloc(size_t size, uint64_t flags, size_t nof_objects,
+                         LatencyStats &stats);
+};
+
+class PmemobjXallocPerfParamTest
+    : public PmemobjXallocPerfTest,
+      public ::testing::WithParamInterface<size_t> {};
+
+#endif  // PMDK_TESTS_XALLOC_PERF_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "perf/perf_report.h"
+#include "xalloc.h"
+
+/**
+ * XALLOC_FLAGS
+ * Parameterized Test Case: Measures throughput and latency of pmemobj_xalloc
+ * for objects of given size (s) with all combinations of POBJ_XALLOC_ZERO,
+ * POBJ_XALLOC_NO_FLUSH, POBJ_CLASS_ID and POBJ_ARENA_ID flags
+ * \test
+ *          \li \c Step1. Register allocation class with unit size s (for s up
+ *          to 64 KiB) and create new arena (if supported by libpmemobj)
+ *          \li \c Step2. Allocate 128 MiB (at least 64 and at most 100000
+ *          objects) with pmemobj_xalloc and given flag combination measuring
+ *          latency of each allocation / SUCCESS
+ *          \li \c Step3. Verify that objects are zeroed if POBJ_XALLOC_ZERO
+ *          is set and free them
+ *          \li \c Step4. Report throughput and latency of the flag
+ *          combination
+ *          \li \c Step5. Repeat steps 2-4 for all flag combinations, skipping
+ *          the ones requiring unavailable allocation class or arena
+ *          \li \c Step6. Report mean cost of zeroing (ZERO compared to no
+ *          flags), flushing (ZERO compared to ZERO|NO_FLUSH), class and arena
+ *          selection
+ */
+TEST_P(PmemobjXallocPerfParamTest, XALLOC_FLAGS) {
+  const size_t size = GetParam();
+  const size_t nof_objects = GetNofObjects(size);
+  std::array<double, XALLOC_ALL + 1> means{};
+
+  /* Step 1 */
+  RegisterClass(size);
+  CreateArena();
+  perf_report::Record("size", size, "B");
+
+  /* Step 5 */
+  for (unsigned index = 0; index <= XALLOC_ALL; ++index) {
+    if (!IsSupported(index)) {
+      continue;
+    }
+
+    /* Step 2 */
+    LatencyStats stats;
+    uint64_t elapsed = MeasureXalloc(size, GetFlags(index), nof_objects, stats);
+    ASSERT_NE(0u, elapsed);
+
+    /* Step 4 */
+    const std::string prefix = FlagsToString(index);
+    perf_report::Record(prefix + "_throughput",
+                        perf_report::OpsPerSec(nof_objects, elapsed),
+                        "allocs/s");
+    perf_report::RecordLatency(prefix, stats);
+    means[index] = stats.GetMean();
+  }
+
+  /* Step 6 */
+  perf_report::Record("zeroing_cost", means[XALLOC_ZERO] - means[0], "ns");
+  perf_report::Record("flush_cost",
+                      means[XALLOC_ZERO] - means[XALLOC_ZERO | XALLOC_NO_FLUSH],
+                      "ns");
+  if (IsSupported(XALLOC_CLASS)) {
+    perf_report::Record("class_cost", means[XALLOC_CLASS] - means[0], "ns");
+  }
+  if (IsSupported(XALLOC_ARENA)) {
+    perf_report::Record("arena_cost", means[XALLOC_ARENA] - means[0], "ns");
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Xalloc, PmemobjXallocPerfParamTest,
+                        ::testing::Values(64, 256, 4 * KIBIBYTE, 64 * KIBIBYTE,
+                                          256 * KIBIBYTE, 4 * MEBIBYTE));
@@ -40,7 +40,41 @@ int LocalConfiguration::FillConfigFields(pugi::xml_node &&root) {
     return -1;
   }
 
-  if (SetTestDir(root, test_dir_) != 0) {
+  if (SetTestDir(root, test_dir_) != 0 ||
+      SetDimmMountpoints(root.child("dimmConfiguration")) != 0 ||
+      SetPerfSoakDuration(root.child("perfSoakDuration")) != 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+int LocalConfiguration::SetDimmMountpoints(pugi::xml_node &&node) {
+  for (auto &&it : node.children("mountPoint")) {
+    std::string mountpoint = it.text().get();
+    if (!ApiC::DirectoryExists(mountpoint)) {
+      std::cerr << "Mountpoint " + mountpoint +
+                       " does not exist and will be skipped. Please change "
+                       "mountPoint field value."
+                << std::endl;
+      continue;
+    }
+    dimm_mountpoints_.emplace_back(mountpoint);
+  }
+
+  return 0;
+}
+
+int LocalConfiguration::SetPerfSoakDuration(pugi::xml_node &&node) {
+  if (node.empty()) {
+    return 0;
+  }
+
+  perf_soak_duration_ = node.text().as_uint(0);
+  if (perf_soak_duration_ == 0) {
+    std::cerr << "Invalid perfSoakDuration value. Please provide positive "
+                 "number of seconds."
+              << std::endl;
     return -1;
   }
 
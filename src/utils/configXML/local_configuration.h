@@ -44,17 +44,45 @@ class LocalConfiguration final : public ReadConfig<LocalConfiguration> {
  private:
   friend class ReadConfig<LocalConfiguration>;
   std::string test_dir_;
+  std::vector<std::string> dimm_mountpoints_;
+  unsigned perf_soak_duration_ = 60;
   /*
    * FillConfigFields -- checks that TestDir exists, creates folder 'pmdk_tests'
    * and assigns this path to test_dir_. Returns 0 on success, prints error
    * message and returns -1 otherwise.
    */
   int FillConfigFields(pugi::xml_node &&root);
+  /*
+   * SetDimmMountpoints -- reads optional 'dimmConfiguration' node. Mountpoints
+   * that do not exist are skipped with a warning. Always returns 0.
+   */
+  int SetDimmMountpoints(pugi::xml_node &&node);
+  /*
+   * SetPerfSoakDuration -- reads optional 'perfSoakDuration' node. Returns 0
+   * on success (also when the node is not present), prints error message and
+   * returns -1 if the value is not a positive number of seconds.
+   */
+  int SetPerfSoakDuration(pugi::xml_node &&node);
 
  public:
   const std::string &GetTestDir() {
     return this->test_dir_;
   }
+  /*
+   * GetDimmMountpoints -- returns mountpoints of NVDIMM devices specified in
+   * 'dimmConfiguration' node. Returns empty vector if the node is not present.
+   */
+  const std::vector<std::string> &GetDimmMountpoints() const {
+    return this->dimm_mountpoints_;
+  }
+  /*
+   * GetPerfSoakDuration -- returns duration in seconds of long-running
+   * performance workloads. Defaults to 60 if 'perfSoakDuration' node is not
+   * present.
+   */
+  unsigned GetPerfSoakDuration() const {
+    return this->perf_soak_duration_;
+  }
 };
 
 #endif  // !PMDK_TESTS_SRC_UTILS_CONFIGXML_LOCAL_CONFIGURATION_H_
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "latency_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+void LatencyStats::Sort() {
+  if (!sorted_) {
+    std::sort(samples_.begin(), samples_.end());
+    sorted_ = true;
+  }
+}
+
+void LatencyStats::Merge(const LatencyStats &other) {
+  samples_.insert(samples_.end(), other.samples_.begin(),
+                  other.samples_.end());
+  sorted_ = false;
+}
+
+uint64_t LatencyStats::GetSum() const {
+  return std::accumulate(samples_.begin(), samples_.end(), uint64_t{0});
+}
+
+double LatencyStats::GetMean() const {
+  if (samples_.empty()) {
+    return 0;
+  }
+  return static_cast<double>(GetSum()) / samples_.size();
+}
+
+uint64_t LatencyStats::GetMin() {
+  return GetPercentile(0);
+}
+
+uint64_t LatencyStats::GetMax() {
+  return GetPercentile(100);
+}
+
+uint64_t LatencyStats::GetPercentile(double percent) {
+  if (samples_.empty()) {
+    return 0;
+  }
+  Sort();
+  size_t idx = static_cast<size_t>(
+      std::ceil(percent / 100.0 * static_cast<double>(samples_.size())));
+  idx = idx == 0 ? 0 : idx - 1;
+  return samples_[std::min(idx, samples_.size() - 1)];
+}
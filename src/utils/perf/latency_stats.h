@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_SRC_UTILS_PERF_LATENCY_STATS_H_
+#define PMDK_TESTS_SRC_UTILS_PERF_LATENCY_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * LatencyStats -- class that collects latency samples specified in nanoseconds
+ * and computes summary statistics over them.
+ */
+class LatencyStats final {
+ private:
+  std::vector<uint64_t> samples_;
+  bool sorted_ = true;
+  void Sort();
+
+ public:
+  void Reserve(size_t count) {
+    samples_.reserve(count);
+  }
+  void Add(uint64_t ns) {
+    samples_.push_back(ns);
+    sorted_ = false;
+  }
+  /*
+   * Merge -- appends all samples collected by other to this object.
+   */
+  void Merge(const LatencyStats &other);
+  size_t GetCount() const {
+    return samples_.size();
+  }
+  uint64_t GetSum() const;
+  double GetMean() const;
+  uint64_t GetMin();
+  uint64_t GetMax();
+  /*
+   * GetPercentile -- returns sample value below which given percent (0-100) of
+   * samples falls. Returns 0 if no samples were collected.
+   */
+  uint64_t GetPercentile(double percent);
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_PERF_LATENCY_STATS_H_
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_SRC_UTILS_PERF_PERF_REPORT_H_
+#define PMDK_TESTS_SRC_UTILS_PERF_PERF_REPORT_H_
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "latency_stats.h"
+
+namespace perf_report {
+/*
+ * Record -- prints measured value to standard output and attaches it as a
+ * property of currently running test, so it is available in the XML report
+ * generated with --gtest_output option.
+ */
+template <typename T>
+void Record(const std::string &name, T value, const std::string &unit = "") {
+  std::ostringstream value_str;
+  value_str << value;
+  std::cout << "[   PERF   ] " << name << ": " << value_str.str()
+            << (unit.empty() ? "" : " " + unit) << std::endl;
+  ::testing::Test::RecordProperty(unit.empty() ? name : name + "[" + unit + "]",
+                                  value_str.str());
+}
+
+/*
+ * RecordLatency -- records number of samples, mean and selected percentiles
+ * of collected latencies, prefixing names of all values with given prefix.
+ */
+static inline void RecordLatency(const std::string &prefix,
+                                 LatencyStats &stats) {
+  Record(prefix + "_count", stats.GetCount());
+  Record(prefix + "_mean", stats.GetMean(), "ns");
+  Record(prefix + "_p50", stats.GetPercentile(50), "ns");
+  Record(prefix + "_p99", stats.GetPercentile(99), "ns");
+  Record(prefix + "_p99.9", stats.GetPercentile(99.9), "ns");
+  Record(prefix + "_max", stats.GetMax(), "ns");
+}
+
+/*
+ * OpsPerSec -- returns number of operations per second for given number of
+ * operations performed in given time specified in nanoseconds.
+ */
+static inline double OpsPerSec(uint64_t nof_ops, uint64_t elapsed_ns) {
+  return elapsed_ns == 0 ? 0 : static_cast<double>(nof_ops) * 1e9 / elapsed_ns;
+}
+}  // namespace perf_report
+
+#endif  // !PMDK_TESTS_SRC_UTILS_PERF_PERF_REPORT_H_
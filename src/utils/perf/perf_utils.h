@@ -0,0 +1,104 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_SRC_UTILS_PERF_PERF_UTILS_H_
+#define PMDK_TESTS_SRC_UTILS_PERF_PERF_UTILS_H_
+
+#include <libpmemobj.h>
+#include <iostream>
+#include <string>
+#include "api_c/api_c.h"
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#include <fstream>
+#endif  // _WIN32
+
+namespace perf_utils {
+/*
+ * HasFreeSpace -- checks that filesystem containing given directory has at
+ * least required number of bytes available. Prints message stating that the
+ * measurement is skipped and returns false otherwise.
+ */
+static inline bool HasFreeSpace(const std::string &dir, size_t required) {
+  long long free_space = ApiC::GetFreeSpaceT(dir);
+  if (free_space < 0 || static_cast<size_t>(free_space) < required) {
+    std::cout << "[   PERF   ] Not enough free space in " << dir
+              << " (required: " << required << ", available: " << free_space
+              << "). Skipping measurement." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/*
+ * GetResidentMemory -- returns resident set size of the current process in
+ * bytes, or 0 if it cannot be determined.
+ */
+static inline size_t GetResidentMemory() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                               sizeof(counters))) {
+    return 0;
+  }
+  return counters.WorkingSetSize;
+#else
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0;
+  size_t resident = 0;
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif  // _WIN32
+}
+
+/*
+ * CountObjects -- iterates over all objects in the pool with pmemobj_first
+ * and pmemobj_next, and returns their number.
+ */
+static inline size_t CountObjects(PMEMobjpool *pop) {
+  size_t count = 0;
+  PMEMoid oid = pmemobj_first(pop);
+  while (!OID_IS_NULL(oid)) {
+    count++;
+    oid = pmemobj_next(oid);
+  }
+  return count;
+}
+}  // namespace perf_utils
+
+#endif  // !PMDK_TESTS_SRC_UTILS_PERF_PERF_UTILS_H_
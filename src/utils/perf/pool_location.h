@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_SRC_UTILS_PERF_POOL_LOCATION_H_
+#define PMDK_TESTS_SRC_UTILS_PERF_POOL_LOCATION_H_
+
+#include <string>
+#include <vector>
+#include "configXML/local_configuration.h"
+
+/*
+ * PoolLocation -- describes directory in which pool used for measurement is
+ * created.
+ */
+struct PoolLocation {
+  std::string name;
+  std::string dir;
+  std::string pool_path;
+
+  PoolLocation(const std::string &name, const std::string &dir,
+               const std::string &pool_path)
+      : name(name), dir(dir), pool_path(pool_path) {
+  }
+};
+
+namespace perf_utils {
+/*
+ * GetPoolLocations -- returns test directory followed by all NVDIMM
+ * mountpoints specified in given configuration, with paths of pools named
+ * pool_name placed in them.
+ */
+static inline std::vector<PoolLocation> GetPoolLocations(
+    LocalConfiguration &config, const std::string &pool_name) {
+  std::vector<PoolLocation> locations;
+  locations.emplace_back("test_dir", config.GetTestDir(),
+                         config.GetTestDir() + pool_name);
+
+  int i = 0;
+  for (const auto &mountpoint : config.GetDimmMountpoints()) {
+    locations.emplace_back("dimm" + std::to_string(i), mountpoint,
+                           mountpoint + SEPARATOR + pool_name);
+    ++i;
+  }
+
+  return locations;
+}
+}  // namespace perf_utils
+
+#endif  // !PMDK_TESTS_SRC_UTILS_PERF_POOL_LOCATION_H_
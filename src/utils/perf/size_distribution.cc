@@ -0,0 +1,199 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "size_distribution.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+/*
+ * MakeLognormal -- returns lognormal distribution with the median equal to
+ * geometric mean of min and max and 99.7% of values within the range. Bounds
+ * are raised to 1 to keep parameters finite for types other than LOGNORMAL
+ * and sigma is kept positive when min equals max.
+ */
+static std::lognormal_distribution<double> MakeLognormal(size_t min,
+                                                         size_t max) {
+  double low = std::max(1.0, static_cast<double>(min));
+  double high = std::max(low, static_cast<double>(max));
+  return std::lognormal_distribution<double>(
+      std::log(std::sqrt(low * high)),
+      std::max(std::log(high / low) / 6,
+               std::numeric_limits<double>::epsilon()));
+}
+
+SizeDistribution::SizeDistribution(SizeDistributionType type, size_t min,
+                                   size_t max, uint64_t seed)
+    : type_(type),
+      /*
+       * logarithmic scale of LOGNORMAL and ZIPF is undefined at 0 and small
+       * mode of BIMODAL would return empty sizes
+       */
+      min_(type == SizeDistributionType::LOGNORMAL ||
+                   type == SizeDistributionType::ZIPF ||
+                   type == SizeDistributionType::BIMODAL
+               ? std::max(min, size_t{1})
+               : min),
+      max_(std::max(min_, max)),
+      generator_(seed),
+      uniform_(min_, max_),
+      lognormal_(MakeLognormal(min_, max_)),
+      small_mode_(min_, std::min(2 * min_, max_)),
+      large_mode_(std::max(max_ / 2, min_), max_),
+      large_(0.1) {
+  if (type_ != SizeDistributionType::ZIPF) {
+    return;
+  }
+
+  std::vector<double> weights;
+  for (size_t bound = min_; bound <= max_; bound *= 2) {
+    values_.push_back(bound);
+    weights.push_back(1.0 / values_.size());
+    if (bound > max_ / 2) {
+      break;
+    }
+  }
+  discrete_ =
+      std::discrete_distribution<size_t>(weights.begin(), weights.end());
+}
+
+SizeDistribution::SizeDistribution(
+    const std::vector<std::pair<size_t, double>> &histogram, uint64_t seed)
+    : type_(SizeDistributionType::HISTOGRAM),
+      min_(0),
+      max_(0),
+      generator_(seed) {
+  std::vector<double> weights;
+  for (const auto &entry : histogram) {
+    values_.push_back(entry.first);
+    weights.push_back(entry.second);
+  }
+
+  if (!values_.empty()) {
+    min_ = *std::min_element(values_.begin(), values_.end());
+    max_ = *std::max_element(values_.begin(), values_.end());
+  }
+  discrete_ =
+      std::discrete_distribution<size_t>(weights.begin(), weights.end());
+}
+
+int SizeDistribution::LoadHistogram(
+    const std::string &path,
+    std::vector<std::pair<size_t, double>> &histogram) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Cannot open histogram file: " << path << std::endl;
+    return -1;
+  }
+
+  std::string line;
+  bool has_weight = false;
+  for (size_t line_no = 1; std::getline(file, line); ++line_no) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream entry(line);
+    /* signed, so that negative sizes are rejected instead of wrapped */
+    long long size;
+    double count;
+    if (!(entry >> size >> count) || !(entry >> std::ws).eof() || size <= 0 ||
+        count < 0) {
+      std::cerr << "Invalid histogram entry in " << path << " at line "
+                << line_no << ": " << line << std::endl;
+      return -1;
+    }
+    has_weight = has_weight || count > 0;
+    histogram.emplace_back(static_cast<size_t>(size), count);
+  }
+
+  if (histogram.empty()) {
+    std::cerr << "Histogram file is empty: " << path << std::endl;
+    return -1;
+  }
+  if (!has_weight) {
+    std::cerr << "Histogram file has no positive counts: " << path
+              << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+size_t SizeDistribution::Next() {
+  switch (type_) {
+    case SizeDistributionType::UNIFORM:
+      return uniform_(generator_);
+    case SizeDistributionType::LOGNORMAL: {
+      double size = std::round(lognormal_(generator_));
+      return std::min(max_, std::max(min_, static_cast<size_t>(size)));
+    }
+    case SizeDistributionType::BIMODAL:
+      return large_(generator_) ? large_mode_(generator_)
+                                : small_mode_(generator_);
+    case SizeDistributionType::ZIPF: {
+      size_t bucket = discrete_(generator_);
+      size_t upper =
+          bucket + 1 < values_.size() ? values_[bucket + 1] - 1 : max_;
+      std::uniform_int_distribution<size_t> size(values_[bucket], upper);
+      return size(generator_);
+    }
+    case SizeDistributionType::HISTOGRAM:
+      return values_.empty() ? 0 : values_[discrete_(generator_)];
+    case SizeDistributionType::FIXED:
+    default:
+      return min_;
+  }
+}
+
+std::string SizeDistribution::GetName() const {
+  std::string range =
+      "[" + std::to_string(min_) + ", " + std::to_string(max_) + "]";
+  switch (type_) {
+    case SizeDistributionType::UNIFORM:
+      return "uniform" + range;
+    case SizeDistributionType::LOGNORMAL:
+      return "lognormal" + range;
+    case SizeDistributionType::BIMODAL:
+      return "bimodal" + range;
+    case SizeDistributionType::ZIPF:
+      return "zipf" + range;
+    case SizeDistributionType::HISTOGRAM:
+      return "histogram" + range;
+    case SizeDistributionType::FIXED:
+    default:
+      return "fixed[" + std::to_string(min_) + "]";
+  }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PMDK_TESTS_SRC_UTILS_PERF_SIZE_DISTRIBUTION_H_
+#define PMDK_TESTS_SRC_UTILS_PERF_SIZE_DISTRIBUTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class SizeDistributionType {
+  FIXED,
+  UNIFORM,
+  LOGNORMAL,
+  BIMODAL,
+  ZIPF,
+  HISTOGRAM
+};
+
+/*
+ * SizeDistribution -- class that draws object sizes from the range [min, max]
+ * according to one of the distributions:
+ *  - FIXED - always returns min
+ *  - UNIFORM - uniform distribution over the whole range
+ *  - LOGNORMAL - lognormal distribution with the median equal to geometric
+ *    mean of min and max, clamped to the range
+ *  - BIMODAL - 90% of sizes uniformly distributed over [min, 2 * min] and 10%
+ *    over [max / 2, max]
+ *  - ZIPF - range split into power of 2 buckets starting at min, k-th bucket
+ *    chosen with probability proportional to 1 / k, size uniformly
+ *    distributed within the bucket
+ *  - HISTOGRAM - sizes recorded in a histogram, each chosen with probability
+ *    proportional to its count
+ * Minimum of LOGNORMAL, BIMODAL and ZIPF distributions is raised to 1 if 0 is
+ * given.
+ */
+class SizeDistribution final {
+ private:
+  SizeDistributionType type_;
+  size_t min_;
+  size_t max_;
+  std::mt19937_64 generator_;
+  std::uniform_int_distribution<size_t> uniform_;
+  std::lognormal_distribution<double> lognormal_;
+  std::uniform_int_distribution<size_t> small_mode_;
+  std::uniform_int_distribution<size_t> large_mode_;
+  std::bernoulli_distribution large_;
+  /* lower bounds of ZIPF buckets or sizes of HISTOGRAM entries */
+  std::vector<size_t> values_;
+  std::discrete_distribution<size_t> discrete_;
+
+ public:
+  SizeDistribution(SizeDistributionType type, size_t min, size_t max,
+                   uint64_t seed = 0);
+  /*
+   * SizeDistribution -- creates HISTOGRAM distribution from pairs of size and
+   * number of its occurrences.
+   */
+  SizeDistribution(const std::vector<std::pair<size_t, double>> &histogram,
+                   uint64_t seed = 0);
+
+  /*
+   * LoadHistogram -- reads histogram from file in which each line holds size
+   * and number of its occurrences separated by whitespace and nothing else.
+   * Empty lines and lines starting with '#' are skipped. Sizes must be
+   * positive, counts must not be negative and at least one count must be
+   * positive. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  static int LoadHistogram(const std::string &path,
+                           std::vector<std::pair<size_t, double>> &histogram);
+
+  size_t Next();
+  size_t GetMin() const {
+    return min_;
+  }
+  size_t GetMax() const {
+    return max_;
+  }
+  /*
+   * GetName -- returns name of the distribution followed by its range.
+   */
+  std::string GetName() const;
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_PERF_SIZE_DISTRIBUTION_H_
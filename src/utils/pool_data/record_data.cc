@@ -0,0 +1,172 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "record_data.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+/*
+ * NextPayloadWord -- splitmix64 step used to generate record payload.
+ */
+static uint64_t NextPayloadWord(uint64_t &state) {
+  uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+size_t RecordData::GetPayloadSize(size_t size) {
+  return std::max(size, sizeof(header)) - sizeof(header);
+}
+
+void RecordData::Fill(header *record, size_t payload_size, uint64_t seed) {
+  char *payload = reinterpret_cast<char *>(record + 1);
+  uint64_t state = seed;
+
+  record->size = payload_size;
+  record->seed = seed;
+  for (size_t off = 0; off < payload_size; off += sizeof(uint64_t)) {
+    uint64_t word = NextPayloadWord(state);
+    memcpy(payload + off, &word,
+           std::min(sizeof(uint64_t), payload_size - off));
+  }
+}
+
+int RecordData::record_constructor(PMEMobjpool *pop, void *ptr, void *arg) {
+  record_args *args = static_cast<record_args *>(arg);
+  Fill(static_cast<header *>(ptr), args->size, args->seed);
+  pmemobj_persist(pop, ptr, sizeof(header) + args->size);
+  return 0;
+}
+
+int RecordData::Write(size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    PMEMoid oid;
+    int ret = Write(oid);
+    if (ret == 1) {
+      std::cerr << "No space left for record " << i << std::endl;
+    }
+    if (ret != 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int RecordData::Write(PMEMoid &oid) {
+  return Write(oid, sizes_.Next());
+}
+
+int RecordData::Write(PMEMoid &oid, size_t size) {
+  record_args args = {GetPayloadSize(size), seed_++};
+  if (pmemobj_alloc(pop_, &oid, sizeof(header) + args.size, type_num_,
+                    record_constructor, &args) != 0) {
+    if (errno == ENOMEM) {
+      return 1;
+    }
+    std::cerr << "Record allocation failed. Errno: " << errno << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+int RecordData::Rewrite(PMEMoid &oid, size_t size) {
+  size_t payload_size = GetPayloadSize(size);
+  if (pmemobj_realloc(pop_, &oid, sizeof(header) + payload_size, type_num_) !=
+      0) {
+    if (errno == ENOMEM) {
+      return 1;
+    }
+    std::cerr << "Record reallocation failed. Errno: " << errno << std::endl;
+    return -1;
+  }
+
+  WriteContent(oid, size);
+  return 0;
+}
+
+PMEMoid RecordData::Reserve(pobj_action *act) {
+  size_t size = sizes_.Next();
+  PMEMoid oid = Reserve(act, size);
+  if (!OID_IS_NULL(oid)) {
+    WriteContent(oid, size);
+  }
+  return oid;
+}
+
+PMEMoid RecordData::Reserve(pobj_action *act, size_t size) {
+  return pmemobj_reserve(pop_, act, sizeof(header) + GetPayloadSize(size),
+                         type_num_);
+}
+
+void RecordData::WriteContent(PMEMoid oid, size_t size) {
+  size_t payload_size = GetPayloadSize(size);
+  Fill(static_cast<header *>(pmemobj_direct(oid)), payload_size, seed_++);
+  pmemobj_persist(pop_, pmemobj_direct(oid), sizeof(header) + payload_size);
+}
+
+bool RecordData::Verify(PMEMoid oid) const {
+  const header *record = static_cast<const header *>(pmemobj_direct(oid));
+  if (record == nullptr ||
+      pmemobj_alloc_usable_size(oid) < sizeof(header) ||
+      pmemobj_alloc_usable_size(oid) - sizeof(header) < record->size) {
+    return false;
+  }
+
+  const char *payload = reinterpret_cast<const char *>(record + 1);
+  uint64_t state = record->seed;
+  for (size_t off = 0; off < record->size; off += sizeof(uint64_t)) {
+    uint64_t word = NextPayloadWord(state);
+    if (memcmp(payload + off, &word,
+               std::min(sizeof(uint64_t), record->size - off)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int RecordData::Verify(size_t &nof_records) const {
+  nof_records = 0;
+  for (PMEMoid oid = POBJ_FIRST_TYPE_NUM(pop_, type_num_); !OID_IS_NULL(oid);
+       oid = POBJ_NEXT_TYPE_NUM(oid)) {
+    if (!Verify(oid)) {
+      std::cerr << "Record at offset " << oid.off << " is corrupted"
+                << std::endl;
+      return -1;
+    }
+    ++nof_records;
+  }
+  return 0;
+}
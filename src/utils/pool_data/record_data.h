@@ -0,0 +1,135 @@
+/*
+ * Copyright 2019, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RECORD_DATA_H
+#define RECORD_DATA_H
+
+#include <libpmemobj.h>
+#include <cstdint>
+#include "perf/size_distribution.h"
+
+/*
+ * RecordData -- writes variable-length records with sizes drawn from given
+ * distribution and verifies them. Each record starts with a header holding
+ * payload size and seed, followed by payload generated from the seed, so that
+ * records can be verified without keeping a copy of written data.
+ */
+class RecordData {
+ public:
+  RecordData(PMEMobjpool *pop, SizeDistribution &sizes, int type_num = 0,
+             uint64_t seed = 0)
+      : pop_(pop), sizes_(sizes), type_num_(type_num), seed_(seed) {
+  }
+
+  /*
+   * Write -- allocates count records. Returns 0 on success, prints error
+   * message and returns -1 otherwise.
+   */
+  int Write(size_t count);
+
+  /*
+   * Write -- allocates single record of size drawn from the distribution.
+   * Returns 0 on success, 1 if there is no space left in the pool, prints
+   * error message and returns -1 on any other error.
+   */
+  int Write(PMEMoid &oid);
+
+  /*
+   * Write -- allocates single record of given size, including the header.
+   * Returns 0 on success, 1 if there is no space left in the pool, prints
+   * error message and returns -1 on any other error.
+   */
+  int Write(PMEMoid &oid, size_t size);
+
+  /*
+   * Rewrite -- reallocates the record to given size, including the header,
+   * and writes new content to it. Returns 0 on success, 1 if there is no
+   * space left in the pool, prints error message and returns -1 on any other
+   * error.
+   */
+  int Rewrite(PMEMoid &oid, size_t size);
+
+  /*
+   * Reserve -- reserves single record of size drawn from the distribution
+   * and writes its content. Record becomes persistent after the action is
+   * published. Returns OID_NULL on failure.
+   */
+  PMEMoid Reserve(pobj_action *act);
+
+  /*
+   * Reserve -- reserves single record of given size, including the header,
+   * without writing its content, which is left to WriteContent. Returns
+   * OID_NULL on failure.
+   */
+  PMEMoid Reserve(pobj_action *act, size_t size);
+
+  /*
+   * WriteContent -- writes and persists header and payload of the record of
+   * given size, including the header.
+   */
+  void WriteContent(PMEMoid oid, size_t size);
+
+  /*
+   * Verify -- checks all records of the type number in the pool and stores
+   * their number in nof_records. Returns 0 if all records are valid, prints
+   * error message and returns -1 otherwise.
+   */
+  int Verify(size_t &nof_records) const;
+
+  /*
+   * Verify -- checks single record. Returns true if the record is valid.
+   */
+  bool Verify(PMEMoid oid) const;
+
+ private:
+  struct header {
+    uint64_t size;
+    uint64_t seed;
+  };
+
+  struct record_args {
+    size_t size;
+    uint64_t seed;
+  };
+
+  static size_t GetPayloadSize(size_t size);
+  static void Fill(header *record, size_t payload_size, uint64_t seed);
+  static int record_constructor(PMEMobjpool *pop, void *ptr, void *arg);
+
+  PMEMobjpool *pop_;
+  SizeDistribution &sizes_;
+  int type_num_;
+  uint64_t seed_;
+};
+
+#endif  // RECORD_DATA_H
@@ -34,9 +34,12 @@
 #define PMDK_TESTS_SRC_UTILS_POOLSET_PART_H_
 
 #include <string>
+#include "constants.h"
 
 /*
  * Part -- class that represents part of replica specified in pool set file.
+ * Part with path ending with SEPARATOR represents directory in which
+ * libpmemobj creates part files as the heap grows, up to given size.
  */
 class Part final {
  private:
@@ -53,6 +56,11 @@ class Part final {
   const std::string &GetPath() const {
     return this->path_;
   };
+  bool IsDirectory() const {
+    return path_.size() >= SEPARATOR.size() &&
+           path_.compare(path_.size() - SEPARATOR.size(), SEPARATOR.size(),
+                         SEPARATOR) == 0;
+  }
 };
 
 #endif  // !PMDK_TESTS_SRC_UTILS_POOLSET_PART_H_